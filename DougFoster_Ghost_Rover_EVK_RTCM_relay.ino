@@ -30,8 +30,46 @@
  *        In the loop(), data is read byte-by-byte from the ZED-F9P UART2 by checkRTCMtoRadio() and transfered to
  *        the HC-12. The HC-12 transmits the serial RTCM3 stream over RF to the rover's receiving HC-12.
  *
+ *        When a full epoch does not fit the HC-12's 9600 bps, MSM frames are decimated per constellation (e.g. GPS &
+ *        Galileo every epoch, GLONASS & BeiDou every second epoch), phased so each epoch carries similar bytes.
+ *        "fcast" scores a forecast of each epoch's bytes off the last epoch's MSM masks against the decimation
+ *        averages (tools/epoch_forecast.py replays both on a capture). It does not beat the averages, so it does
+ *        not steer decimation.
+ *
  *        An LED mounted on the EVK back panel blinks once for every RTCM3 sentence transmitted.
  *
+ *        Every 10 s, in idle airtime, the relay injects an RTCM 1029 text frame with its own telemetry (uptime,
+ *        frames in/out, drops, queue high-water, airtime, input stall). Decode it with tools/rtcm_telemetry.py.
+ *
+ *        For battery use, the "power" command selects what the relay does in the gap between epoch bursts: run (busy
+ *        poll), idle (80 MHz + WFI) or sleep (light sleep to just before the next burst). tools/energy_model.py
+ *        estimates the saving from a flight recorder dump.
+ *
+ *        Firmware updates stream over USB (tools/usb_update.py) into the inactive OTA slot without stopping the relay;
+ *        flash writes & the final reboot are timed into inter-epoch gaps.
+ *
+ *        The ZED's UART2 speed is detected at boot & after a stall or a garbage stream: candidate speeds are
+ *        scored by CRC-valid RTCM3 frames ("baud", "cfg autobaud"). Frames at the last good speed are relayed while
+ *        it is checked; output is held only while other speeds are tried.
+ *
+ *        Serial speeds, telemetry period & boot-time debug/decimation/power settings live in one CRC-protected NVS
+ *        blob ("cfg" command: show, set, commit). Compiled-in constants are the defaults.
+ *
+ *        Besides the text console, the USB port carries a COBS framed binary protocol for automation (stats,
+ *        latency & watchdog histograms, task CPU, config, commands) - tools/relay_client.py.
+ *
+ *        The relay learns the base's message set, periods & sizes from the stream ("profile"), warns when it can't
+ *        fit the HC-12 & seeds decimation from it.
+ *
+ *        Optionally ("cfg hop 1") the radio hop drops the RTCM3 preamble, reserved bits & CRC-24Q for a 1-2 byte
+ *        length & CRC-16; the rover side rebuilds standard RTCM3 bit-exactly (tools/rtcm_hop.py).
+ *
+ *        The same firmware is the rover end with "cfg role 1" (receiver): HC-12 in on Serial1, CRC-valid RTCM3
+ *        (rebuilt if compact) out on Serial0 TX to the rover's GNSS, with gap, age & epoch loss stats ("rx").
+ *        "cfg role 2" (repeater) sends valid frames on again on a 2nd HC-12 on another channel (GR_RADIO2, cfg
+ *        radio2 dup/split); duplicates, echoes & stale frames are dropped by frame tag & epoch time at repeaters &
+ *        receivers.
+ *
  * --- Major components. ---
  *     -- EVK   https://www.sparkfun.com/sparkfun-rtk-evk.html.
  *     -- MCU   https://www.sparkfun.com/sparkfun-thing-plus-esp32-c6.html.
@@ -53,8 +91,30 @@
  * 
  * --- Dev environment. ---
  *     -- IDE        VS Code & Arduino Maker Workshop 1.0.8 extension (uses Arduino CLI 1.4).
+ *     -- Production build: arduino-cli compile --build-property "build.extra_flags=-DGR_DEBUG=0" ... compiles out
+ *        the testLEDr, testRad & debugRad commands & the code behind them. Run "bench" on a debug & a production
+ *        build: each keeps its result in NVS & prints the sketch size & kernel cycles of both side by side.
+ *     -- Second radio: -DGR_RADIO2=1 drives a 2nd HC-12 (own channel) from the LP UART (GPIO 5 TX, 4 RX - fixed
+ *        pins), so the ZED moves to GPIO 6/7. "radio2" / "cfg radio2" select off, dup or split.
+ *     -- IRAM hot path: -DGR_IRAM=1 puts the sketch's per-byte & per-frame relay functions (HOT_FN) in IRAM:
+ *        framing, CRC, relay/decimate decision (rtcmDecide()), hop encoding, counters, flight recorder & latency
+ *        (rtcmFrameDone()). Their tables (CRC, decimation ratios, links) are RAM variables. Not in
+ *        IRAM: the Arduino Serial0/1 read & write calls (core, flash), & checkFrameDone() - end of epoch planning,
+ *        base profile, speed score, debug dump, LED - one loop() pass after the frame. What it buys: no cache
+ *        misses on the byte path in the passes after a flash op (cache refill). What it does not: the flash ops
+ *        themselves (cfg commit - Preferences, USB update - Update.write) run in loop(), the same task as the byte
+ *        path, so relaying stops for each erase/write in any build. Input then waits in the UART: the RX ISR is
+ *        not in IRAM (prebuilt core, CONFIG_UART_ISR_IN_IRAM off), so it is held off too & only the 128 byte RX
+ *        FIFO takes bytes - a long erase at high ZED speeds can overflow it. "hot" shows loop() pass times by
+ *        flash activity.
+ *     -- Throughput: "selftest" feeds a sample epoch through the relay at 57600 - 921600 bps (radio output sunk) &
+ *        prints the input ceiling & CPU per stage. "selftest loop" goes through the UART: RTCM_OUT jumpered to
+ *        RTCM_IN, ZED TX2 unplugged.
  * 
  * --- Caveats. ---
+ *     -- The flight recorder (RTC no-init RAM) survives software, watchdog, panic & brown-out resets, not power-on.
+ *     -- Power mode "sleep" (light sleep) drops the USB console while asleep. After a reset it only idles for the
+ *        first 30 s (POWER_SLEEP_GRACE), so "power" / "cfg power 0" can still be typed even if sleep was committed.
  * --- TODO: ---
  * --- Code organization. ---
  *     -- Include libraries.
@@ -80,6 +140,16 @@
 #include <Arduino.h>            // https://github.com/espressif/arduino-esp32.
 #include <esp_system.h>         // https://github.com/pycom/esp-idf-2.0/blob/master/components/esp32/include/esp_system.h.
 #include <esp_chip_info.h>      // https://github.com/pycom/pycom-esp-idf.
+#include <esp_heap_caps.h>      // https://docs.espressif.com/projects/esp-idf/en/stable/esp32c6/api-reference/system/mem_alloc.html.
+#include <esp_timer.h>          // https://docs.espressif.com/projects/esp-idf/en/stable/esp32c6/api-reference/system/esp_timer.html.
+#include <esp_sleep.h>          // https://docs.espressif.com/projects/esp-idf/en/stable/esp32c6/api-reference/system/sleep_modes.html.
+#include <driver/gpio.h>        // https://docs.espressif.com/projects/esp-idf/en/stable/esp32c6/api-reference/peripherals/gpio.html.
+#include <driver/uart.h>        // https://docs.espressif.com/projects/esp-idf/en/stable/esp32c6/api-reference/peripherals/uart.html.
+#include <Update.h>             // https://docs.espressif.com/projects/arduino-esp32/en/latest/api/update.html.
+#include <Preferences.h>        // https://docs.espressif.com/projects/arduino-esp32/en/latest/api/preferences.html.
+#include <esp_cpu.h>            // https://docs.espressif.com/projects/esp-idf/en/stable/esp32c6/api-reference/system/misc_system_api.html.
+#include <hal/cache_hal.h>      // https://github.com/espressif/esp-idf/blob/master/components/hal/include/hal/cache_hal.h.
+#include <soc/soc.h>            // SOC_IROM_LOW/HIGH (C6: code & rodata share one flash cache mapping).
 
 // --- Additional. ---
 
@@ -91,27 +161,714 @@
  * @since  3.0.9 [2025-12-15-06:30pm] New.
  */
 
+// --- Build options. ---
+#ifndef GR_DEBUG
+#define GR_DEBUG 1                          // 0 = production: debug & test features compile out.
+#endif
+constexpr bool DEBUG_BUILD = (GR_DEBUG != 0);
+#ifndef GR_RADIO2
+#define GR_RADIO2 0                         // 1 = second HC-12 on the LP UART (ZED moves to GPIO 6/7 - rewire).
+#endif
+constexpr bool RADIO2_BUILD = (GR_RADIO2 != 0);
+#ifndef GR_IRAM
+#define GR_IRAM 0                           // 1 = relay per-byte & per-frame path runs from IRAM (no flash cache misses).
+#endif
+#if GR_IRAM
+#define HOT_FN IRAM_ATTR
+#else
+#define HOT_FN
+#endif
+constexpr bool IRAM_BUILD = (GR_IRAM != 0);
+#ifndef GR_ROLE
+#define GR_ROLE 0                           // Default cfg role: 0 = relay (ZED -> HC-12), 1 = receiver (HC-12 -> GNSS),
+                                            // 2 = repeater (HC-12 -> 2nd HC-12, needs GR_RADIO2).
+#endif
+static_assert((GR_ROLE != 2) || (GR_RADIO2 != 0), "GR_ROLE 2 (repeater) needs GR_RADIO2 = 1 (2nd HC-12).");
+
 // --- Pin asignments. ---
 
 // -- Serial0 (UART0). --
+#if GR_RADIO2
+const uint8_t RTCM_IN  = 6;                 // ZED TX2 (RTCM) {green wire}. GPIO 4/5 are the LP UART's fixed pins.
+const uint8_t RTCM_OUT = 7;                 // ZED RX2 (not used) <- RTCM {yellow wire}.
+#else
 const uint8_t RTCM_IN  = 5;                 // ZED TX2 (RTCM) {green wire}.
 const uint8_t RTCM_OUT = 4;                 // ZED RX2 (not used) <- RTCM {yellow wire}.
+#endif
 
 // -- Serial1 (UART1). --   
 const uint8_t HC12_TX  = 16;                // HC-12 TXD {yellow wire}.
 const uint8_t HC12_RX  = 17;                // HC-12 RXD {white wire}.
 const uint8_t HC12_SET =  2;                // HC-12 SET {blue wire}.
 
+// -- SerialLP (LP UART, GR_RADIO2). Second HC-12, configured (channel, speed) beforehand. --
+const uint8_t HC12B_TX = 5;                 // LP_UART_TXD (fixed pin) -> 2nd HC-12 RXD.
+const uint8_t HC12B_RX = 4;                 // LP_UART_RXD (fixed pin) <- 2nd HC-12 TXD.
+
 // -- LED. --
 const uint8_t LED_RADIO = 3;                // Red LED {blue wire}.
 
 // --- Serial. ---
 const uint32_t SERIAL_USB_SPEED = 115200;   // Serial USB speed.
-const uint32_t SERIAL0_SPEED    = 57600;    // ZED default speed.
-const uint32_t SERIAL1_SPEED    = 9600;     // HC-12 default speed.
+const uint32_t SERIAL0_SPEED    = 57600;    // ZED default speed (config.serial0Speed, first tried by autobaud).
+const uint32_t SERIAL1_SPEED    = 9600;     // HC-12 default speed (config.serial1Speed).
+const size_t   SERIAL0_RX_BUF   = 1024;     // Serial0 RX ring buffer (bytes). Holds the boot burst while the banner prints.
       char monitorChar;                     // Monitor i/o character.  // ToDo.
       char serialChar;                      // Serial i/o character.
-      char rtcmSentence[300];               // RTCM3 sentence buffer.
+
+// --- RTCM3 framing. ---
+const uint8_t  RTCM_PREAMBLE    = 0xd3;                         // Frame preamble.
+const uint16_t RTCM_MAX_PAYLOAD = 1023;                         // 10 bit length field.
+const uint16_t RTCM_MAX_FRAME   = RTCM_MAX_PAYLOAD + 6;         // Preamble + length (3) + payload + CRC-24Q (3).
+      char     rtcmSentence[RTCM_MAX_FRAME];                    // RTCM3 sentence buffer.
+      uint32_t crc24qTable[256];                                // CRC-24Q lookup table.
+struct rtcmParser {                                             // Framing state, one per byte stream.
+    uint8_t * buf;                                              // RTCM_MAX_FRAME bytes.
+    uint16_t  count;                                            // Bytes in buf, 0 = hunting for preamble.
+    uint16_t  frameLen;                                         // Expected frame length once the header is in, else 0.
+    uint32_t  crc;                                              // Running CRC-24Q.
+};
+enum rtcmEvent : uint8_t {                                      // rtcmParse() result.
+    RTCM_HUNT,                                                  // Byte outside a frame (dropped).
+    RTCM_BYTE,                                                  // Byte added to the frame.
+    RTCM_FALSE,                                                 // False preamble (reserved bits set) - hunt again.
+    RTCM_FRAME_OK,                                              // Frame complete, CRC-24Q good.
+    RTCM_FRAME_BAD                                              // Frame complete, CRC-24Q failed.
+};
+      rtcmParser rtcmRx;                                        // Serial0 (ZED) parser, buffer rtcmSentence.
+      int64_t  radioAirUntil;                                   // Modelled HC-12 TX queue drains at (esp_timer us).
+      uint32_t radioSpeed;                                      // Serial1 (HC-12) running speed (bps), set at boot.
+      int64_t  radioByteUs;                                     // Serial1 wire time per byte (8N1, us).
+
+// --- Bit fields (RTCM3 is MSB first). ---
+constexpr bool BITS_CHECKED = DEBUG_BUILD;                      // Bounds checks (compile out in production).
+struct bitReader {                                              // Sequential reader, 64 bit refill window.
+    const uint8_t * buf;                                        // Buffer.
+    uint32_t        bytes;                                      // Buffer length.
+    uint32_t        next;                                       // Next byte to load.
+    uint64_t        window;                                     // Unread bits, left aligned.
+    uint8_t         count;                                      // Unread bits in window.
+    bool            overrun;                                    // Read past the end / bad width (BITS_CHECKED).
+};
+struct bitWriter {                                              // Sequential writer, 64 bit window.
+    uint8_t *       buf;                                        // Buffer.
+    uint32_t        bytes;                                      // Buffer length.
+    uint32_t        next;                                       // Next byte to store.
+    uint64_t        window;                                     // Pending bits, left aligned.
+    uint8_t         count;                                      // Pending bits in window.
+    bool            overrun;                                    // Write past the end / bad width (BITS_CHECKED).
+};
+
+// --- Flight recorder (survives reset in RTC no-init RAM). ---
+const uint32_t FR_MAGIC       = 0x47524604;                     // "GRF" + layout version. Bump when structs change.
+const uint16_t FR_RECORDS     = 256;                            // Ring size (power of 2).
+const uint8_t  FR_RELAYED     = 1;                              // Decision: relayed to HC-12.
+const uint8_t  FR_DECIMATED   = 2;                              // Decision: MSM decimated (not sent).
+const uint8_t  FR_REINIT      = 3;                              // Decision: watchdog re-init (type = 0 Serial0, 1 Serial1).
+const uint8_t  FR_HELD        = 4;                              // Decision: held during a ZED speed scan (not sent).
+const uint8_t  FR_BOOT        = 7;                              // Decision: boot marker (type = reset reason).
+struct flightRecord {                                           // One frame. 12 bytes, 3 stores.
+    uint32_t arrival;                                           // First byte in (ms since boot).
+    uint32_t meta;                                              // [31:20] type, [19:10] length, [9] CRC ok, [8:6] decision.
+    uint32_t txDone;                                            // Modelled on air complete (ms since boot).
+};
+struct flightCounters {                                         // Key counters.
+    uint32_t bytesIn;                                           // Bytes read from ZED.
+    uint32_t framesIn;                                          // RTCM3 frames parsed.
+    uint32_t crcErrors;                                         // Frames failing CRC-24Q.
+    uint32_t framesOut;                                         // Frames relayed.
+    uint32_t resyncs;                                           // False preambles (reserved bits set).
+    uint32_t rxOverflows;                                       // Serial0 RX FIFO / buffer overflows.
+    uint32_t telemetryOut;                                      // Telemetry frames injected.
+    uint32_t decimated;                                         // MSM frames decimated.
+    uint32_t uptime;                                            // Last frame (ms since boot).
+};
+struct flightRecorder {
+    uint32_t       magic;                                       // FR_MAGIC when valid.
+    uint32_t       bootCount;                                   // Boots recorded.
+    uint32_t       check;                                       // Checksum of magic, bootCount & layout (set at boot).
+    uint32_t       head;                                        // Records written (ring index = head % FR_RECORDS).
+    flightCounters now;                                         // This boot.
+    flightCounters prev;                                        // Previous boot (recovered).
+    flightRecord   rec[FR_RECORDS];                             // Frame ring.
+};
+RTC_NOINIT_ATTR flightRecorder flightRec;                       // Not cleared by reset.
+      bool     flightRecRecovered;                              // Previous boot's recorder was valid.
+
+// --- Telemetry (RTCM 1029 text, injected into idle airtime). ---
+const uint16_t TELEM_MSG_TYPE  = 1029;                          // Unicode text string message.
+const uint32_t TELEM_PERIOD    = 10000;                         // Send every (ms). Default (config.telemPeriod).
+const uint32_t TELEM_QUIET     = 50;                            // Input quiet for (ms) - epoch burst is over.
+const uint32_t INPUT_STALL     = 3000;                          // No input for (ms) = stalled.
+const uint8_t  TELEM_STALL_NOW = 0x01;                          // Stall flag: input stalled now.
+const uint8_t  TELEM_STALL_WIN = 0x02;                          // Stall flag: input stalled during interval.
+      uint8_t  telemFrame[128];                                 // Telemetry frame buffer.
+      char     telemText[100];                                  // Last telemetry text.
+      uint32_t telemSeq;                                        // Telemetry sequence number.
+      uint32_t telemLast;                                       // Last sent (ms).
+      uint32_t telemAirBusy;                                    // Radio busy since last telemetry (us).
+      uint16_t telemRxHighWater;                                // Serial0 RX queue high-water since last telemetry.
+      uint8_t  telemStall;                                      // Stall flags.
+      uint16_t rtcmStationId;                                   // Reference station ID (1005/1006/MSM).
+      bool     rtcmInFrame;                                     // Parser is inside a frame.
+      int64_t  rtcmLastByte;                                    // Last byte in (esp_timer us).
+struct frameDoneState {                                         // Frame done, flash side left for checkFrameDone().
+    bool     pending;                                           // Set by rtcmFrameDone(), cleared by checkFrameDone().
+    uint16_t msgType;                                           // Message type.
+    int8_t   gnss;                                              // MSM constellation, -1 = not MSM.
+    uint16_t frameLen;                                          // Frame length (preamble to CRC).
+    uint16_t airLen;                                            // Frame bytes on air.
+    uint16_t station;                                           // Station ID (1005/1006/MSM), else 0.
+    bool     crcOk;                                             // CRC-24Q passed.
+    bool     relayed;                                           // Sent to the HC-12.
+    bool     epochDone;                                         // Last MSM of the epoch - close it.
+};
+      frameDoneState frameDone;
+
+// --- Epoch decimation (per constellation MSM rate). ---
+const uint8_t  RTCM_DECIDE_AT   = 10;                           // Bytes held before the relay/decimate decision (MSM header).
+const uint8_t  GNSS_NUM         = 7;                            // MSM constellations (1071-1137).
+const char*    GNSS_NAMES[GNSS_NUM] = {"GPS", "GLO", "GAL", "SBAS", "QZSS", "BDS", "NavIC"};
+const uint8_t  DECIM_PRIORITY[GNSS_NUM] = {0, 2, 5, 1, 4, 3, 6};  // Highest priority first (GPS, GAL, BDS, GLO, ...).
+const uint8_t  DECIM_MAX_RATIO  = 4;                            // Send at least every (epochs).
+const uint8_t  DECIM_CYCLE      = 12;                           // LCM(1..DECIM_MAX_RATIO) - phase planning cycle.
+const uint8_t  DECIM_BUDGET_PCT = 90;                           // Plan to this % of Serial1 capacity.
+const uint8_t  DECIM_RELAX_PCT  = 80;                           // Lower a ratio when the result fits this % (hysteresis).
+const uint32_t DECIM_EPOCH_GAP  = 200;                          // MSM gap (ms) that starts a new epoch.
+struct decimState {
+    bool     enabled;                                           // Decimation allowed.
+    uint32_t epoch;                                             // Epoch counter.
+    bool     epochOpen;                                         // MSMs of current epoch still arriving.
+    int64_t  epochStart;                                        // First MSM of current epoch (us).
+    int64_t  lastMsm;                                           // Last MSM in (us).
+    uint32_t periodMs;                                          // Epoch period (EMA, ms).
+    uint16_t epochBytes[GNSS_NUM];                              // MSM bytes in current epoch (demand, sent or not).
+    uint32_t otherBytes;                                        // Non-MSM bytes since last epoch (always sent).
+    uint32_t avgBytes[GNSS_NUM];                                // MSM bytes per epoch (EMA).
+    uint32_t avgOther;                                          // Non-MSM bytes per epoch (EMA).
+    uint8_t  ratio[GNSS_NUM];                                   // Send every (epochs).
+    uint8_t  phase[GNSS_NUM];                                   // Send when (epoch + phase) % ratio == 0.
+    uint32_t budget;                                            // MSM bytes per epoch that fit.
+};
+decimState decim;
+
+// --- Base profile (message set, periods & sizes learned from the input). ---
+const uint8_t  PROFILE_TYPES    = 16;                           // Message types tracked.
+const uint8_t  PROFILE_EPOCHS   = 5;                            // Epochs before the profile is used.
+const uint32_t PROFILE_UNSEEN   = 60000;                        // Drop a type seen once after (ms).
+struct profileType {
+    uint16_t type;                                              // RTCM3 message type.
+    int8_t   gnss;                                              // MSM constellation, -1 = not MSM.
+    uint32_t frames;                                            // CRC-valid frames.
+    uint32_t occurrences;                                       // Epochs the type was sent in.
+    uint32_t epoch;                                             // decim.epoch of the current occurrence.
+    uint32_t firstMs;                                           // First seen (ms).
+    uint32_t startMs;                                           // Current occurrence start (ms).
+    uint32_t lastMs;                                            // Last frame (ms).
+    uint32_t periodMs;                                          // Between occurrences (EMA, ms), 0 = seen once.
+    uint16_t bytes;                                             // Air bytes so far in the current occurrence.
+    uint16_t sizeMin;                                           // Air bytes per occurrence.
+    uint16_t sizeMax;
+    uint16_t sizeAvg;                                           // EMA, 0 = no complete occurrence yet.
+};
+struct profileState {
+    bool        learned;                                        // Used for the forecast & decimation seed.
+    bool        fits;                                           // Forecast within DECIM_BUDGET_PCT of capacity.
+    uint16_t    station;                                        // Base station ID (change = relearn).
+    uint32_t    epoch;                                          // Last decim.epoch seen.
+    uint32_t    startEpoch;                                     // Learning started.
+    uint8_t     count;                                          // Types in use.
+    uint32_t    untracked;                                      // Frames of types past PROFILE_TYPES.
+    uint32_t    relearns;
+    uint32_t    forecast;                                       // Air bytes/s.
+    uint32_t    capacity;                                       // Radio bytes/s (airtime model, all links).
+    profileType types[PROFILE_TYPES];
+};
+      profileState profile;
+
+// --- Epoch byte forecast (MSM satellite / signal / cell masks). ---
+const uint16_t MSM_HEADER_BITS  = 169;                          // MSM header up to the cell mask.
+const uint8_t  MSM_SAT_BITS[7]  = {10, 10, 10, 18, 36, 18, 36}; // MSM1-7 satellite data (bits per satellite).
+const uint8_t  MSM_CELL_BITS[7] = {15, 27, 42, 48, 63, 65, 80}; // MSM1-7 signal data (bits per cell).
+struct fcastMasks {
+    uint16_t type;                                              // MSM message type.
+    uint8_t  frames;                                            // MSM frames (multiple message bit).
+    uint16_t sats;                                              // Satellite mask bits set.
+    uint16_t maskBits;                                          // Cell mask bits (satellites x signals).
+    uint16_t cells;                                             // Cell mask bits set.
+};
+struct fcastState {
+    fcastMasks now[GNSS_NUM];                                   // Current epoch so far.
+    fcastMasks last[GNSS_NUM];                                  // Previous epoch.
+    bool       open;                                            // Forecast made for the current epoch.
+    uint32_t   forecast;                                        // Epoch air bytes (all MSM & non-MSM), at its first MSM.
+    uint32_t   baseline;                                        // Decimation averages (EMA) at the same point.
+    uint32_t   epochs;                                          // Epochs measured.
+    uint64_t   errAbs;                                          // Sum |actual - forecast| (bytes).
+    int64_t    errSum;                                          // Sum actual - forecast (bias).
+    uint32_t   errMax;
+    uint64_t   baseErrAbs;                                      // Sum |actual - baseline|.
+    uint64_t   actual;                                          // Sum actual.
+};
+      fcastState fcast;
+
+// --- Serial0 (ZED) speed detection. ---
+const uint8_t  BAUD_RATES_NUM   = 8;
+const uint32_t BAUD_RATES[BAUD_RATES_NUM] = {57600, 115200, 230400, 460800, 921600, 38400, 19200, 9600};
+const uint32_t BAUD_WINDOW_MS   = 1500;                         // Per candidate, once bytes flow (> 1 epoch burst).
+const uint32_t BAUD_MIN_BYTES   = 64;                           // Bytes before a window counts (line not quiet).
+const uint8_t  BAUD_MIN_FRAMES  = 2;                            // CRC-valid frames to lock (1 at the last good speed).
+const uint32_t BAUD_GARBAGE_MS  = 3000;                         // Locked, bytes in, no valid frame - scan again (ms).
+enum baudStage : uint8_t {
+    BAUD_LOCKED,                                                // Relaying.
+    BAUD_SCAN                                                   // Trying candidates, relay held (see provisional).
+};
+struct baudState {
+    baudStage stage;
+    uint8_t   idx;                                              // Candidate (0 = config.serial0Speed).
+    bool      provisional;                                      // Scan relays at idx 0 (last good) until it moves on.
+    uint32_t  rate;                                             // Serial0 now (bps).
+    uint32_t  scanStart;                                        // ms.
+    uint32_t  windowStart;                                      // ms.
+    uint32_t  bytesAt;                                          // flightRec.now.bytesIn at window start.
+    uint32_t  bytesAtValid;                                     // ... at the last CRC-valid frame (locked).
+    uint32_t  lastValid;                                        // Last CRC-valid frame (ms).
+    uint16_t  ok;                                               // CRC-valid frames this window.
+    uint16_t  bad;                                              // CRC failed frames this window.
+    uint16_t  score[BAUD_RATES_NUM + 1];                        // Last pass, valid frames per candidate.
+    uint32_t  scans;                                            // Scans started.
+    uint32_t  locks;
+    uint32_t  changes;                                          // Locks at another speed.
+    uint32_t  lockMs;                                           // Last scan to lock (ms).
+};
+      baudState baud;
+
+// --- Radio links (HC-12 on Serial1, 2nd HC-12 on SerialLP). ---
+#if GR_RADIO2
+HardwareSerial SerialLP(LP_UART_NUM_0);                         // LP UART.
+#endif
+const uint8_t  RADIO_LINKS = 2;
+const uint8_t  LINK_1      = 0x01;                              // Route bits.
+const uint8_t  LINK_2      = 0x02;
+const uint8_t  LINK_BOTH   = LINK_1 | LINK_2;
+const size_t   RADIO_TX_BUF = 2048;                             // Per link TX ring - each drains at its own pace.
+enum radio2Mode : uint8_t {
+    RADIO2_OFF,                                                 // Serial1 only.
+    RADIO2_DUP,                                                 // Every frame on both links (diversity).
+    RADIO2_SPLIT,                                               // Non-MSM on both, MSM constellations split (~2x air).
+    RADIO2_MODES
+};
+const char*    RADIO2_NAMES[RADIO2_MODES] = {"off", "dup", "split"};
+      int64_t  radioLinkUntil[RADIO_LINKS];                     // Per link modelled TX queue drain (us).
+      uint32_t radioLinkBytes[RADIO_LINKS];                     // Per link bytes sent.
+      uint8_t  rtcmRoute;                                       // Links for the current frame.
+      uint8_t  gnssLink[GNSS_NUM];                              // Split: link per constellation.
+
+// --- Radio hop encoding. ---
+enum hopMode : uint8_t {
+    HOP_RTCM,                                                   // Standard RTCM3 frames.
+    HOP_COMPACT,                                                // [length 1-2][payload][CRC-16] - rover rebuilds RTCM3.
+    HOP_MODES
+};
+const char*    HOP_NAMES[HOP_MODES] = {"rtcm", "compact"};
+struct hopState {
+    uint16_t crc;                                               // Running CRC-16 of the frame being sent.
+    uint8_t  links;                                             // Links of the frame being sent.
+    uint32_t frames;                                            // Frames sent compact.
+    uint32_t poisoned;                                          // Sent with a bad CRC-16 (CRC-24Q failed at input).
+    uint32_t rtcmBytes;                                         // Relayed bytes as RTCM3.
+    uint32_t saved;                                             // Bytes compact saves (would save if off).
+    uint32_t epochSaved;                                        // This epoch.
+    uint32_t avgSaved;                                          // Per epoch (EWMA 1/4).
+    uint32_t maxSaved;                                          // Per epoch.
+};
+      hopState hop;
+      uint16_t crc16Table[256];                                 // CRC-16/CCITT lookup table.
+
+// --- USB binary protocol (COBS frames, multiplexed with the text console). ---
+const uint8_t  BIN_VERSION     = 1;                             // Protocol version (BIN_INFO).
+const size_t   BIN_MAX_PAYLOAD = 240;                           // Response + COBS + delimiters fit HWCDC's 256 byte TX buffer.
+enum binOp : uint8_t {                                          // Request op. Response op = op | 0x80.
+    BIN_INFO = 1,                                               // Build, uptime & protocol stats.
+    BIN_STATS,                                                  // Counters, decimation, links, hop, watchdog.
+    BIN_LATENCY,                                                // Epoch to air latency per constellation.
+    BIN_WDOG,                                                   // Watchdog histograms.
+    BIN_TASKS,                                                  // Task CPU & stack (task monitor).
+    BIN_CFG_GET,                                                // Config table.
+    BIN_CFG_SET,                                                // Config field set / commit / default.
+    BIN_CMD                                                     // Text console command (output on the console).
+};
+const uint8_t  BIN_OK          = 0;                             // Response status.
+const uint8_t  BIN_BAD_OP      = 1;
+const uint8_t  BIN_BAD_ARG     = 2;
+const uint8_t  BIN_BUSY        = 3;
+const char*    BIN_CMD_ALLOWED[] = {                            // BIN_CMD allow-list: show only (no arguments), short.
+    "tasks", "heap", "boot", "telem", "lat", "cfg", "hop", "hot", "rx", "profile", "fcast"
+};                                                              // Not: decim (toggles), bench, selftest, reset, rec, ...
+struct binState {
+    bool     inFrame;                                           // Between 0x00 delimiters.
+    bool     overflow;                                          // Request too long - drop.
+    uint16_t len;                                               // Encoded request bytes.
+    uint8_t  rx[BIN_MAX_PAYLOAD + 2];                           // Encoded request.
+    char     inject[41];                                        // BIN_CMD text, fed to the console parser.
+    uint8_t  injectPos;
+    uint32_t requests;
+    uint32_t errors;                                            // Bad frames / ops.
+    uint32_t dropped;                                           // Responses dropped (USB TX full).
+    uint32_t lastUs;                                            // Request handling time (us).
+    uint32_t maxUs;
+};
+      binState bin;
+
+// --- On-device kernel bench. ---
+enum benchKernelId : uint8_t {
+    BENCH_FRAMING,                                              // rtcmParse() over the sample stream.
+    BENCH_CRC24Q,                                               // crc24q() per frame.
+    BENCH_BITS,                                                 // MSM header & satellite data fields, bitReader.
+    BENCH_HOP,                                                  // Compact hop encode (length & CRC-16).
+    BENCH_SCHED,                                                // Decimation plan, decimEpochDone() (per epoch).
+    BENCH_KERNELS
+};
+const char*    BENCH_NAMES[BENCH_KERNELS] = {"framing", "crc24q", "bits", "hop", "sched"};
+const uint8_t  BENCH_FRAMES    = 6;                             // Sample frames (1005, 1230, 4 MSM7).
+const uint8_t  BENCH_WARM      = 20;                            // Warm passes averaged.
+const size_t   BENCH_STREAM    = 1400;                          // Sample stream buffer (bytes).
+const char     BENCH_KEY_DEBUG[] = "benchD";                    // NVS keys (CONFIG_NAMESPACE), one run per build.
+const char     BENCH_KEY_PROD[]  = "benchP";
+struct benchRecord {                                            // Debug vs production comparison.
+    char     build[24];                                         // BUILD_DATE.
+    uint32_t sketchBytes;                                       // ESP.getSketchSize().
+    uint32_t mhz;                                               // CPU clock.
+    uint32_t warm[BENCH_KERNELS];                               // Warm cycles per frame (sched: per epoch).
+};
+
+// --- Throughput self test (synthetic RTCM3 into the relay pipeline, output sunk). ---
+enum selfTestMode : uint8_t {
+    ST_OFF,
+    ST_INTERNAL,                                                // Generator replaces Serial0 (paced, virtual RX ring).
+    ST_LOOPBACK                                                 // Generator writes Serial0 TX, jumpered to RX (ZED off).
+};
+enum selfTestStage : uint8_t {
+    ST_INPUT,                                                   // UART read & timestamp (or generator).
+    ST_FRAME,                                                   // rtcmParse().
+    ST_OUTPUT,                                                  // Decision & encode (radio writes sunk).
+    ST_DONE,                                                    // rtcmFrameDone() & checkFrameDone() bookkeeping.
+    ST_STAGES
+};
+const char*    ST_STAGE_NAMES[ST_STAGES] = {"input", "frame", "output", "done"};
+const uint8_t  ST_STEPS         = 5;
+const uint32_t ST_RATES[ST_STEPS] = {57600, 115200, 230400, 460800, 921600};   // Input rate steps (bps).
+const uint32_t ST_STEP_MS       = 3000;                         // Feed per step (ms).
+const uint32_t ST_DRAIN_MS      = 300;                          // Then let the relay catch up (ms).
+struct selfTestResult {
+    uint32_t rate;                                              // bps.
+    uint32_t fed;                                               // Bytes generated.
+    uint32_t in;                                                // Bytes the relay read.
+    uint32_t framesFed;                                         // Whole frames generated.
+    uint32_t framesOk;                                          // CRC-valid frames framed.
+    uint32_t crcErrors;
+    uint32_t overflows;                                         // RX ring overflow bytes (internal: virtual ring).
+    uint32_t backlogMax;                                        // RX ring high-water (bytes).
+    uint32_t loopRate;                                          // loop() passes/s.
+    uint16_t cpu[ST_STAGES];                                    // Per stage CPU (0.1%).
+};
+struct selfTestState {
+    selfTestMode   mode;
+    uint8_t        step;
+    bool           feeding;                                     // Feed phase (else drain).
+    uint32_t       stepStart;                                   // ms.
+    int64_t        feedStartUs;
+    int64_t        feedEndUs;
+    uint32_t       fed;                                         // Bytes generated this step.
+    uint32_t       taken;                                       // Internal: bytes read from the virtual ring.
+    uint32_t       lost;                                        // Internal: bytes the virtual ring dropped.
+    uint32_t       backlogMax;
+    uint32_t       loops;                                       // loopCount at step start.
+    uint32_t       sunk;                                        // Radio bytes not sent.
+    uint64_t       cycles[ST_STAGES];                           // This step.
+    uint16_t       genPos;                                      // Position in stream.
+    uint16_t       len;                                         // Stream bytes.
+    uint16_t       lens[BENCH_FRAMES];
+    uint8_t        stream[BENCH_STREAM];                        // Sample epoch (benchSamples()).
+    flightCounters base;                                        // Counters at step start.
+    flightCounters saved;                                       // Restored after the test.
+    decimState     savedDecim;
+    hopState       savedHop;
+    uint16_t       savedStation;
+    selfTestResult result[ST_STEPS];
+};
+      selfTestState selfTest;
+
+// --- Input stall watchdog. ---
+const uint32_t WDOG_CHECK       = 50;                           // Check every (ms).
+const uint32_t WDOG_MARGIN      = 200;                          // Stall = quiet for 1.5 epochs + this (ms).
+const uint32_t WDOG_TX_SLACK    = 2000;                         // Serial1 TX not draining this long after the model says done (ms).
+const uint32_t WDOG_BACKOFF_MAX = 30000;                        // Re-init retry interval cap while still stalled (ms).
+const uint8_t  WDOG_BUCKETS     = 8;
+const uint32_t WDOG_BUCKET_MS[WDOG_BUCKETS] = {250, 500, 1000, 2000, 5000, 10000, 30000, UINT32_MAX};
+struct wdogState {
+    bool     stalled;                                           // Input stall detected, not recovered yet.
+    uint32_t lastCheck;                                         // ms.
+    uint32_t detectedAt;                                        // Stall detected (ms).
+    uint32_t nextReinit;                                        // Next re-init while stalled (ms).
+    uint32_t backoff;                                           // Re-init interval (ms).
+    uint32_t rxReinits;                                         // Serial0 re-inits.
+    uint32_t txReinits;                                         // Serial1 re-inits.
+    uint32_t txSpace;                                           // Serial1.availableForWrite() at last check.
+    uint32_t txSpaceMax;                                        // Serial1.availableForWrite() when idle.
+    uint32_t detectHist[WDOG_BUCKETS];                          // Burst due to stall detected (ms).
+    uint32_t recoverHist[WDOG_BUCKETS];                         // Stall detected to first byte in (ms).
+    uint32_t lastDetect;                                        // ms.
+    uint32_t lastRecover;                                       // ms.
+};
+      wdogState wdog;
+      bool      rtcmResync;                                     // Drop any partial frame (parser).
+
+// --- Hot path & flash operations (loop() pass time outliers). ---
+enum passClass : uint8_t {
+    PASS_QUIET,                                                 // No flash op nearby.
+    PASS_FLASH,                                                 // Flash op (erase/write) inside the pass.
+    PASS_AFTER,                                                 // Within FLASH_AFTER_US of a flash op (cache refill).
+    PASS_CLASSES
+};
+const char*    PASS_NAMES[PASS_CLASSES] = {"quiet", "flash", "after"};
+const uint8_t  PASS_BUCKETS     = 8;
+const uint32_t PASS_BUCKET_US[PASS_BUCKETS] = {50, 100, 200, 500, 1000, 2000, 5000, UINT32_MAX};
+const uint32_t PASS_OUTLIER_US  = 1000;                         // Pass longer than this = outlier.
+const uint32_t FLASH_AFTER_US   = 50000;                        // Cache refill window after a flash op (us).
+struct hotState {
+    uint32_t lastPass;                                          // Previous pass start (us).
+    bool     busy;                                              // Relay busy at previous pass (in frame / input pending).
+    uint32_t flashOpsAtPass;                                    // flashOps at previous pass.
+    uint32_t flashStart;                                        // Current flash op start (us).
+    uint32_t flashEnd;                                          // Last flash op end (us).
+    uint32_t flashOps;                                          // NVS commits & OTA sector writes.
+    uint32_t flashMaxUs;                                        // Longest flash op (us).
+    uint32_t hist[PASS_CLASSES][PASS_BUCKETS];                  // Busy pass time (us).
+    uint32_t outliers[PASS_CLASSES];                            // Busy passes > PASS_OUTLIER_US.
+    uint32_t maxUs[PASS_CLASSES];                               // Longest busy pass (us).
+    uint32_t since;                                             // Stats cleared (ms).
+};
+      hotState hot;
+
+// --- Role (cfg role, reboot). Receiver: HC-12 in on Serial1, validated RTCM3 out on Serial0 TX to the GNSS. ---
+// --- Repeater: HC-12 in on Serial1, validated RTCM3 out again on the 2nd HC-12 (GR_RADIO2, own channel) only. ---
+enum relayRole : uint8_t {
+    ROLE_RELAY,                                                 // Base: ZED -> HC-12.
+    ROLE_RECEIVER,                                              // Rover: HC-12 -> GNSS.
+    ROLE_REPEATER,                                              // Range extension: HC-12 -> HC-12.
+    ROLE_MODES
+};
+const char*    ROLE_NAMES[ROLE_MODES] = {"relay", "receiver", "repeater"};
+const uint32_t RX_SYNC_GAP   = 20;                              // Radio quiet for (ms) = next byte starts a frame (compact).
+const uint8_t  RX_SEEN       = 32;                              // Recent frame tags kept (duplicate & echo suppression).
+const uint32_t RX_DUP_WINDOW = 3000;                            // Same MSM tag within (ms) = duplicate (has epoch time).
+const uint32_t RX_DUP_STATIC = 500;                             // Non-MSM (1005 etc. repeat): half epoch, at most (ms).
+const uint32_t RX_MAX_AGE    = 1500;                            // Frame older than newest epoch / queued longer (ms) = drop.
+struct rxSeen {
+    uint32_t tag;                                               // CRC-24Q << 8 | length (low 8 bits).
+    uint32_t at;                                                // ms.
+};
+struct repeatState {
+    uint32_t frames;                                            // Frames repeated.
+    uint32_t bytes;
+    uint32_t queueDrops;                                        // Would air later than RX_MAX_AGE.
+    uint32_t latLast;                                           // Added latency: frame in to repeat off air (ms).
+    uint32_t latMin;
+    uint32_t latMax;
+    uint32_t latSum;
+};
+struct rxState {
+    uint32_t lastByte;                                          // Last radio byte (ms).
+    uint16_t hopCount;                                          // Compact frame bytes so far.
+    uint16_t hopLen;                                            // Compact payload length.
+    uint8_t  hopHead;                                           // Compact length bytes (1-2).
+    uint16_t hopCrc;                                            // Running CRC-16.
+    uint16_t hopRxCrc;                                          // Received CRC-16.
+    bool     hopSynced;                                         // Frame boundary known.
+    uint8_t  hopBad;                                            // Consecutive CRC-16 failures.
+    uint32_t bytesIn;                                           // Radio bytes.
+    uint32_t framesOk;                                          // CRC-valid frames.
+    uint32_t crcErrors;                                         // Broken on air.
+    uint32_t poisoned;                                          // Sent poisoned by the relay (CRC-24Q failed there).
+    uint32_t framesOut;                                         // Frames to the GNSS.
+    uint32_t bytesOut;
+    uint32_t outDrops;                                          // Serial0 TX full.
+    uint32_t lastFrame;                                         // Last valid frame (ms).
+    uint32_t maxGap;                                            // Longest gap between valid frames (ms).
+    uint32_t gapHist[WDOG_BUCKETS];                             // Gap between valid frames (ms).
+    int64_t  lastEpoch;                                         // Last MSM epoch (GPS ms of week), -1 = none.
+    uint32_t periodMs;                                          // Epoch period (shortest step seen, ms).
+    uint32_t epochs;                                            // Epochs received.
+    uint32_t epochsLost;                                        // Epochs missing between received ones.
+    uint32_t dups;                                              // Duplicates & echoes dropped.
+    uint32_t stale;                                             // Too old (behind the newest epoch) dropped.
+    rxSeen   seen[RX_SEEN];                                     // Recent frame tags (ring).
+    uint8_t  seenHead;
+    repeatState rep;                                            // Repeater.
+    uint32_t since;                                             // Stats since (ms).
+};
+      relayRole role;                                           // Running role (config.role at boot).
+      rxState   rx;
+
+// --- GNSS time latency (MSM epoch time to on air). ---
+const int64_t  GPS_WEEK_MS       = 604800000;                   // ms per week.
+const int64_t  GPS_LEAP_MS       = 18000;                       // GPS - UTC (since 2017-01-01).
+const int64_t  GLO_UTC_MS        = 10800000;                    // GLONASS time - UTC (UTC(SU) + 3 h).
+const int64_t  BDS_GPS_MS        = 14000;                       // GPS - BDT.
+const uint8_t  LAT_WINDOW        = 64;                          // Offset estimate window (epochs).
+const int64_t  ZED_LATENCY_FLOOR = 0;                           // ZED epoch to first byte, fastest case (us). 0 = unknown.
+struct latencyStats {                                           // Per constellation (ms).
+    uint32_t n;                                                 // Frames measured.
+    int32_t  lastIn;                                            // Epoch to last byte in (ZED + UART2 wire).
+    int32_t  last;                                              // Epoch to on air (+ relay queue + HC-12 airtime).
+    int32_t  avg;                                               // Epoch to on air (EMA).
+    int32_t  min;                                               // Epoch to on air.
+    int32_t  max;                                               // Epoch to on air.
+};
+      int64_t  latRing[LAT_WINDOW];                             // First MSM arrival - epoch time (us), per epoch.
+      uint8_t  latHead;                                         // Next ring slot.
+      uint8_t  latCount;                                        // Valid ring slots.
+      int64_t  latOffset;                                       // Local clock - GNSS time (us), window minimum.
+      int64_t  rtcmFrameEpoch;                                  // Current MSM's epoch (GPS ms of week), -1 if none.
+      latencyStats latStats[GNSS_NUM];
+
+// --- Serial0 arrival timestamps (UART RX events). ---
+const uint8_t  RX_FIFO_FULL   = 16;                             // RX FIFO threshold (bytes) - event mid burst.
+const uint8_t  RX_TIMEOUT_SYM = 2;                              // RX timeout (symbols) - event when a burst pauses.
+const uint8_t  RX_MARKS       = 32;                             // Event marks kept.
+struct rxMark {
+    uint32_t end;                                               // Serial0 bytes received up to this event.
+    uint16_t count;                                             // Bytes since the previous mark.
+    int64_t  at;                                                // Event time (esp_timer us).
+};
+struct rxTsState {
+    rxMark   marks[RX_MARKS];                                   // Ring, written by the UART event task.
+    uint8_t  head;                                              // Next slot.
+    uint8_t  cursor;                                            // Mark of the byte being read (loop()).
+    uint32_t readIdx;                                           // Serial0 bytes read by loop().
+    int64_t  byteUs;                                            // Serial0 wire time per byte (8N1, us).
+    uint32_t events;                                            // onReceive() calls.
+    uint32_t fallbacks;                                         // Bytes with no mark - read time used.
+    uint32_t jitterMax;                                         // Event time vs bytes, back to back FIFO events (us).
+    uint32_t jitterAvg;                                         // EMA (us).
+    uint32_t lagMax;                                            // loop() read - arrival (us): the error read time had.
+    uint32_t lagAvg;                                            // EMA (us).
+};
+      rxTsState    rxTs;
+      portMUX_TYPE rxTsMux = portMUX_INITIALIZER_UNLOCKED;      // Guards rxTs marks.
+
+// --- Power (inter-epoch gap). ---
+enum powerMode : uint8_t {                                      // Gap behaviour.
+    POWER_RUN,                                                  // Busy poll @ CPU_MHZ_RUN (original).
+    POWER_IDLE,                                                 // CPU_MHZ_IDLE, loop() blocks 1 tick (WFI). UART keeps receiving.
+    POWER_SLEEP,                                                // Light sleep until the predicted burst - POWER_GUARD.
+    POWER_MODES
+};
+const char*    POWER_NAMES[POWER_MODES] = {"run", "idle", "sleep"};
+const uint32_t CPU_MHZ_RUN        = 160;                        // Burst CPU clock (MHz).
+const uint32_t CPU_MHZ_IDLE       = 80;                         // Gap CPU clock (MHz).
+const int64_t  POWER_GAP_US       = 60000;                      // Input quiet for (us) = gap. > TELEM_QUIET so telemetry goes first.
+const int64_t  POWER_GUARD_US     = 20000;                      // Wake ahead of the predicted burst (us).
+const int64_t  POWER_MIN_SLEEP_US = 10000;                      // Shorter sleeps are not worth it (us).
+const uint32_t POWER_SLEEP_GRACE  = 30000;                      // Sleep mode only idles this long after boot (ms).
+const float    POWER_MA_RUN       = 30.0;                       // Energy model (mA): 160 MHz busy. Approx., ESP32-C6 datasheet.
+const float    POWER_MA_IDLE      = 12.0;                       // 80 MHz, mostly WFI.
+const float    POWER_MA_SLEEP     = 0.25;                       // Light sleep (CPU powered down, RAM retained).
+struct powerState {
+    powerMode mode;                                             // Selected mode.
+    bool      slow;                                             // CPU at CPU_MHZ_IDLE.
+    bool      inGap;                                            // Between bursts.
+    int64_t   burstStart;                                       // Latest burst's first byte seen (us).
+    int64_t   periodUs;                                         // Burst period (us, EMA).
+    int64_t   wokeAt;                                           // Last light sleep wake (us), 0 = none pending.
+    int64_t   since;                                            // Stats since (us).
+    int64_t   idleUs;                                           // Time blocked in idle.
+    int64_t   sleepUs;                                          // Time in light sleep.
+    uint32_t  sleeps;                                           // Light sleeps.
+    uint32_t  lateWakes;                                        // Woken by RTCM_IN (guard too short, first bytes lost).
+    int32_t   marginLast;                                       // Timer wake to burst start (ms).
+    int32_t   marginMin;                                        // Timer wake to burst start, smallest (ms).
+};
+      powerState power;
+
+// --- Firmware update (USB console -> inactive OTA slot). ---
+enum updateStage : uint8_t {
+    UPDATE_IDLE,                                                // Not updating.
+    UPDATE_HEADER,                                              // Waiting for "<size> [md5]\n".
+    UPDATE_DATA,                                                // Receiving image.
+    UPDATE_REBOOT                                               // Verified, reboot in the next gap.
+};
+const uint16_t UPDATE_SECTOR    = 4096;                         // Flash sector - one erase & write per gap.
+const int64_t  UPDATE_FLASH_US  = 150000;                       // Next burst at least this far away to write a sector (us).
+const int64_t  UPDATE_REBOOT_US = 500000;                       // Next burst at least this far away to reboot (us).
+const uint32_t UPDATE_TIMEOUT   = 10000;                        // Host silent for (ms) = abort.
+struct updateState {
+    updateStage stage;
+    uint32_t    size;                                           // Image bytes.
+    uint32_t    received;                                       // Bytes from host.
+    uint32_t    written;                                        // Bytes to flash.
+    uint16_t    fill;                                           // Bytes in updateBuf.
+    uint8_t     headerLen;
+    char        header[48];                                     // "<size> [md5]".
+    uint32_t    lastRx;                                         // Last host byte (ms).
+    uint32_t    started;                                        // Update start (ms).
+    uint32_t    flashWrites;                                    // Sector writes.
+    uint32_t    flashMaxUs;                                     // Longest sector write (loop() blocked).
+    uint32_t    deferred;                                       // Sector writes held for a gap.
+    uint32_t    overflows;                                      // rxOverflows at start.
+    uint32_t    crcErrors;                                      // crcErrors at start.
+};
+      updateState update;
+      uint8_t     updateBuf[UPDATE_SECTOR];                     // One sector of image.
+
+// --- Configuration (NVS, loaded once before Serial0.begin()). ---
+const char     CONFIG_NAMESPACE[]  = "grr";                     // NVS namespace.
+const char     CONFIG_KEY[]        = "cfg";                     // NVS key (one blob).
+const uint16_t CONFIG_VERSION      = 5;                         // Bump when relayConfig changes.
+const uint32_t CONFIG_MIN_WRITE_MS = 10000;                     // Commits closer than this are coalesced (ms).
+struct relayConfig {                                            // Persistent settings. All uint32_t, table driven.
+    uint16_t version;                                           // CONFIG_VERSION.
+    uint16_t size;                                              // sizeof(relayConfig).
+    uint32_t serial0Speed;                                      // ZED (bps). Reboot.
+    uint32_t serial1Speed;                                      // HC-12 (bps) - must match its AT+B setting. Reboot.
+    uint32_t telemPeriod;                                       // Telemetry period (ms), 0 = off.
+    uint32_t debugRad;                                          // debugRad at boot.
+    uint32_t decim;                                             // Decimation at boot.
+    uint32_t power;                                             // Power mode at boot.
+    uint32_t radio2;                                            // Second radio mode (GR_RADIO2 builds).
+    uint32_t hop;                                               // Radio hop encoding.
+    uint32_t role;                                              // Relay / receiver. Reboot.
+    uint32_t autobaud;                                          // Detect the ZED speed (relay role).
+    uint32_t crc;                                               // CRC-24Q of the above.
+};
+struct configField {                                            // Console get/set table entry.
+    const char *          name;
+    uint32_t relayConfig::* field;
+    uint32_t              lo;
+    uint32_t              hi;
+    bool                  reboot;                               // Applies at next boot.
+};
+const configField CONFIG_FIELDS[] = {
+    {"serial0",  &relayConfig::serial0Speed, 9600, 921600, true},
+    {"serial1",  &relayConfig::serial1Speed, 1200, 115200, true},
+    {"telem",    &relayConfig::telemPeriod,  0,    3600000, false},
+    {"debugRad", &relayConfig::debugRad,     0,    1,      false},
+    {"decim",    &relayConfig::decim,        0,    1,      false},
+    {"power",    &relayConfig::power,        0,    POWER_MODES - 1, false},
+    {"radio2",   &relayConfig::radio2,       0,    (RADIO2_BUILD ? RADIO2_MODES - 1 : 0), false},
+    {"hop",      &relayConfig::hop,          0,    HOP_MODES - 1, false},
+    {"role",     &relayConfig::role,         0,    (RADIO2_BUILD ? ROLE_MODES - 1 : ROLE_REPEATER - 1), true},
+    {"autobaud", &relayConfig::autobaud,     0,    1,      false}
+};
+const uint8_t  CONFIG_NUM_FIELDS = sizeof(CONFIG_FIELDS) / sizeof(CONFIG_FIELDS[0]);
+      relayConfig config;                                       // Live settings.
+      relayConfig configStored;                                 // As in NVS (or defaults).
+const char *      configSource;                                 // Where config came from.
+      uint32_t    configLoadUs;                                 // NVS read time (us).
+      bool        configPending;                                // Commit requested.
+      uint32_t    configLastWrite;                              // Last NVS write (ms).
+      uint32_t    configWrites;                                 // NVS writes this boot.
 
 // --- I2C. ---
 // Power only.
@@ -119,36 +876,143 @@ const uint32_t SERIAL1_SPEED    = 9600;     // HC-12 default speed.
 // --- Timing. ---
 const TickType_t LED_TIME_FLASH_ON = 100/portTICK_PERIOD_MS;  // Time (ms).
 
+// --- Boot phases. ---
+enum bootPhase : uint8_t {                                      // Boot phase timestamps (esp_timer, us since reset).
+    BOOT_SETUP,                                                 // setup() entered.
+    BOOT_CONFIG,                                                // Config loaded from NVS.
+    BOOT_SERIAL0,                                               // Serial0 (ZED) up.
+    BOOT_SERIAL1,                                               // Serial1 (HC-12) up.
+    BOOT_LOOP,                                                  // loop() started.
+    BOOT_FIRST_IN,                                              // First byte in from ZED.
+    BOOT_FIRST_OUT,                                             // First RTCM3 frame relayed to HC-12.
+    BOOT_PHASES
+};
+const char*    BOOT_PHASE_NAMES[BOOT_PHASES] = {
+                   "setup()", "config loaded", "Serial0 up", "Serial1 up", "loop()", "first byte in", "first frame out"
+};
+const uint32_t BOOT_BANNER_DELAY = 3000;                        // Show banner anyway after (ms), if no RTCM3 yet.
+      int64_t  bootTime[BOOT_PHASES];                           // Boot phase timestamps (us).
+      int64_t  bootFirstAir;                                    // First relayed frame modelled on air (esp_timer us).
+      bool     bootBannerShown;                                 // Deferred banner shown.
+
 // --- Task handles. ---
 TaskHandle_t radioRtcmLEDtaskHandle;            // Radio RTCM LED task handle.
+TaskHandle_t taskMonitorTaskHandle;             // Task monitor (sampler) task handle.
+
+// --- Task memory (static, no heap). ---
+const uint32_t RADIO_LED_TASK_STACK   = 2048;                   // Stack size (bytes).
+const uint32_t TASK_MON_TASK_STACK    = 2048;                   // Stack size (bytes).
+StackType_t    radioRtcmLEDtaskStack[RADIO_LED_TASK_STACK];     // Radio RTCM LED task stack.
+StaticTask_t   radioRtcmLEDtaskTCB;                             // Radio RTCM LED task control block.
+StackType_t    taskMonitorTaskStack[TASK_MON_TASK_STACK];       // Task monitor task stack.
+StaticTask_t   taskMonitorTaskTCB;                              // Task monitor task control block.
+
+// --- Heap tracking. ---
+#ifdef CONFIG_HEAP_USE_HOOKS
+constexpr bool HEAP_HOOKS = true;                               // IDF heap alloc/free hooks in this core.
+#else
+constexpr bool HEAP_HOOKS = false;                              // Prebuilt core without them - operator new only.
+#endif
+uint32_t       heapNewCount;                                    // operator new calls after startLoop().
+uint32_t       heapNewBytes;                                    // Bytes requested by those calls.
+uint32_t       heapAllocCount;                                  // All heap allocations after startLoop() (HEAP_HOOKS).
+uint32_t       heapAllocBytes;                                  // Bytes requested by those.
+uint32_t       heapFreeCount;                                   // Frees after startLoop() (HEAP_HOOKS).
+size_t         heapLoopBlocks;                                  // Allocated heap blocks at startLoop().
+size_t         heapLoopFree;                                    // Free heap at startLoop() (bytes).
+size_t         heapPeakBlocks;                                  // Peak allocated blocks since startLoop().
+size_t         heapMinLargest;                                  // Smallest largest-free-block since startLoop().
+multi_heap_info_t heapInfo;                                     // Last heap sample.
+bool           heapWarned;                                      // Steady state allocation warning issued.
+
+// --- Task monitor. ---
+const uint8_t    TASK_MON_MAX_TASKS = 16;                       // Max tasks tracked.
+const uint8_t    TASK_MON_WINDOW    = 10;                       // Sliding window (samples).
+const TickType_t TASK_MON_PERIOD    = 1000/portTICK_PERIOD_MS;  // Sample period (ms).
+const uint32_t   TASK_MON_STACK_LOW = 256;                      // Stack high-water warning threshold (bytes).
+struct taskMonEntry {                                           // Per task sample history.
+    UBaseType_t taskNumber;                                     // FreeRTOS task number (unique per task).
+    char        name[16];                                       // Task name.
+    uint32_t    runTime[TASK_MON_WINDOW + 1];                   // Run time counter ring (us).
+    uint32_t    stackHighWater;                                 // Stack high-water mark (bytes never used).
+    uint32_t    cpuPeak;                                        // Peak single-sample CPU (0.1%).
+    UBaseType_t priority;                                       // Current priority.
+    eTaskState  state;                                          // Last seen state.
+    bool        alive;                                          // Seen in last sample.
+    bool        stackWarned;                                    // Low stack warning issued.
+};
+TaskStatus_t   taskMonStatus[TASK_MON_MAX_TASKS];               // uxTaskGetSystemState() snapshot.
+taskMonEntry   taskMon[TASK_MON_MAX_TASKS];                     // Tracked tasks.
+taskMonEntry   taskMonWork[TASK_MON_MAX_TASKS];                 // Next taskMon, built outside the lock (monitor only).
+uint32_t       taskMonTotal[TASK_MON_WINDOW + 1];               // Total run time ring (us).
+uint32_t       taskMonLoops[TASK_MON_WINDOW + 1];               // loop() pass count ring.
+uint32_t       taskMonLoopRateMin;                              // Lowest loop() rate since boot (passes/s).
+uint8_t        taskMonHead;                                     // Ring index of newest sample.
+uint8_t        taskMonSamples;                                  // Valid samples in ring.
+uint32_t       loopCount;                                       // loop() pass counter.
+uint32_t       radioRtcmLEDwakes;                               // Radio RTCM LED task wake-ups.
+uint32_t       taskMonitorWakes;                                // Task monitor wake-ups.
+portMUX_TYPE   taskMonMux = portMUX_INITIALIZER_UNLOCKED;       // Guards task monitor rings.
 
 // --- Operation. ---
-const uint8_t NUM_COMMANDS           = 4;       // How many possible commands.
+const uint8_t NUM_COMMANDS           = 25;       // How many possible commands.
 const char    EXIT_TEST              = '!';     // Exit test mode.
 const char*   COMMANDS[NUM_COMMANDS] = {        // Valid commands. Point to array of C-strings.
                                          "testLEDr",
                                          "testRad",
                                          "debugRad",
-                                         "reset"
+                                         "reset",
+                                         "tasks",
+                                         "heap",
+                                         "boot",
+                                         "rec",
+                                         "telem",
+                                         "decim",
+                                         "lat",
+                                         "power",
+                                         "update",
+                                         "cfg",
+                                         "bits",
+                                         "radio2",
+                                         "wdog",
+                                         "hop",
+                                         "bench",
+                                         "hot",
+                                         "rx",
+                                         "selftest",
+                                         "profile",
+                                         "fcast",
+                                         "baud"
+};
+template <bool Enabled> struct debugFlag {     // Debug/test switch, set at run time.
+    bool on = false;
+    operator bool() const { return on; }
+    debugFlag & operator=(bool value) { on = value; return *this; }
+};
+template <> struct debugFlag<false> {           // Production: constant false, so "if (flag) {...}" compiles out.
+    constexpr operator bool() const { return false; }
+    debugFlag & operator=(bool) { return *this; }
 };
       char    monitorCommand[11];               // Serial monitor command (C-string). // ToDo.
       char    radioCommand[11];                 // serial (radio) test command (C-string). // ToDo.
-      bool    testLEDr;                         // Test radio LED.
-      bool    testRad;                          // Test radio.
-      bool    debugRad;                         // Debug radio.
+      debugFlag<DEBUG_BUILD> testLEDr;          // Test radio LED.
+      debugFlag<DEBUG_BUILD> testRad;           // Test radio.
+      debugFlag<DEBUG_BUILD> debugRad;          // Debug radio.
       bool    reset;                            // Reset MCU.
       bool    inLoop;                           // In loop indicator.
 esp_chip_info_t chip_info;                      // Chip info.
 
 // --- Version. ---
-const char BUILD_DATE[]  = "[2025-12-30-06:30pm]";
+const char BUILD_DATE[]  = "[2026-10-18-04:30am]";
 const char MAJOR_VERSION = '3';
-const char MINOR_VERSION = '0';
-const char PATCH_VERSION = '10';
+const char MINOR_VERSION = '1';
+const char PATCH_VERSION = '0';
 const char NAME[]        = "Ghost Rover 3 - RTCM Relay";
 
 // --- Declaration. ---
 void updateLED(char);
+void radioRtcmLEDtask(void *);
+void taskMonitorTask(void *);
 
 // --- Test. ---
 
@@ -160,19 +1024,224 @@ void updateLED(char);
 
 /**
  * ------------------------------------------------
- *      Display build & processor info.
+ *      Display build, processor & startup info.
  * ------------------------------------------------
  *
+ * Deferred from setup() - called from loop() by checkBootBanner() once the relay path is running.
+ *
  * @return void  No output is returned.
  * @since  3.0.10 [2025-12-30-02:00pm].
- * @see    setup().
+ * @since  3.1.0  [2026-10-17-11:00am] Deferred. Startup info moved here.
+ * @since  3.1.0  [2026-10-17-05:00pm] Debug or production build.
+ * @since  3.1.0  [2026-10-17-08:00pm] Config source.
+ * @see    checkBootBanner().
  */
 void showBuild() {
-    Serial.begin(SERIAL_USB_SPEED);
-    Serial.printf("\n%s, Version: %c.%c.%c, Build date: %s\n", NAME, MAJOR_VERSION, MINOR_VERSION, PATCH_VERSION, BUILD_DATE);
+    Serial.printf("\n%s, Version: %c.%c.%c, Build date: %s, %s build\n", NAME, MAJOR_VERSION, MINOR_VERSION,
+                  PATCH_VERSION, BUILD_DATE, (DEBUG_BUILD ? "debug" : "production"));
     esp_chip_info(&chip_info);
     Serial.printf("Using %s, Rev %d, %d core(s), ID (MAC) %012llX.\n",
     ESP.getChipModel(), chip_info.revision, chip_info.cores, ESP.getEfuseMac());
+    Serial.printf("Serial (USB) started @ %lu bps.\n",    (unsigned long) SERIAL_USB_SPEED);
+    Serial.printf("Role: %s.\n", ROLE_NAMES[role]);
+    Serial.printf("Serial0 (%s) started @ %lu bps.\n",
+                  ((role == ROLE_RELAY) ? "ZED" : ((role == ROLE_RECEIVER) ? "GNSS" : "unused")),
+                  (unsigned long) baud.rate);
+    Serial.printf("Serial1 (HC-12) started @ %lu bps.\n", (unsigned long) radioSpeed);
+    Serial.printf("Config: %s.\n", configSource);
+    Serial.println("Task started: \"RTCM SEND status LED\".");
+    Serial.println("Task started: \"Task monitor\".");
+    Serial.println("Loop() started.");
+}
+
+/**
+ * ------------------------------------------------
+ *      Record boot phase timestamp.
+ * ------------------------------------------------
+ *
+ * First call per phase wins.
+ *
+ * @param  bootPhase phase Boot phase.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:00am] New.
+ * @see    showBoot().
+ */
+void bootMark(bootPhase phase) {
+    if (bootTime[phase] == 0) {
+        bootTime[phase] = esp_timer_get_time();
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Build CRC-24Q table.
+ * ------------------------------------------------
+ *
+ * CRC-24Q (Qualcomm), polynomial 0x1864CFB, as used by RTCM3. Also CRC-16/CCITT (0x1021) for the compact hop.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-12:00pm] New.
+ * @since  3.1.0 [2026-10-17-11:30pm] CRC-16 table.
+ * @see    initVars().
+ * @link   https://github.com/tomojitakasu/RTKLIB/blob/master/src/rtkcmn.c.
+ */
+void initCrc24q() {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i << 16;
+        for (uint8_t j = 0; j < 8; j++) {
+            crc <<= 1;
+            if (crc & 0x1000000) {
+                crc ^= 0x1864cfb;
+            }
+        }
+        crc24qTable[i] = crc & 0xffffff;
+    }
+    for (uint32_t i = 0; i < 256; i++) {                            // CRC-16/CCITT (radio hop).
+        uint16_t crc = i << 8;
+        for (uint8_t j = 0; j < 8; j++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+        crc16Table[i] = crc;
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Recover flight recorder.
+ * ------------------------------------------------
+ *
+ * RTC no-init RAM keeps its contents over software, watchdog, panic & brown-out resets (not power-on). A valid
+ * recorder keeps its ring - a boot marker record is appended - and this boot's counters move to prev. Otherwise
+ * the recorder is cleared.
+ *
+ * Valid = invariant header (magic, bootCount, layout) checksums & head counts at least one boot marker per boot.
+ * Counters & head change on every byte without a checksum update, so a reset mid-burst still recovers; counters
+ * that fail recorderPlausible() are dropped (prev zeroed) rather than the ring. Records are checked when dumped.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-12:00pm] New.
+ * @since  3.1.1 [2026-10-18-05:00am] Checksum the invariant header only; range check head & counters.
+ * @see    initVars().
+ * @see    showRecorder().
+ */
+void recorderRecover() {
+    flightRecRecovered = (flightRec.magic == FR_MAGIC) && (flightRec.check == recorderCheck())
+                      && (flightRec.head >= flightRec.bootCount);
+    if (flightRecRecovered) {
+        flightRec.bootCount++;
+        flightRec.prev = flightRec.now;
+        if (!recorderPlausible(&flightRec.prev)) {
+            memset(&flightRec.prev, 0, sizeof(flightRec.prev));
+        }
+    } else {
+        memset(&flightRec, 0, sizeof(flightRec));
+        flightRec.magic     = FR_MAGIC;
+        flightRec.bootCount = 1;
+    }
+    memset(&flightRec.now, 0, sizeof(flightRec.now));
+    flightRecord * r = &flightRec.rec[flightRec.head % FR_RECORDS];  // Boot marker.
+    r->arrival = millis();
+    r->meta    = ((uint32_t) esp_reset_reason() << 20) | ((uint32_t) FR_BOOT << 6);
+    r->txDone  = flightRec.bootCount;
+    flightRec.head++;
+    flightRec.check = recorderCheck();
+}
+
+/**
+ * ------------------------------------------------
+ *      Flight recorder header checksum.
+ * ------------------------------------------------
+ *
+ * Rotate-XOR over the words that only change at boot (magic, bootCount) & the recorder size, so a layout change
+ * also invalidates. head & counters are range checked instead (see recorderRecover()).
+ *
+ * @return uint32_t Checksum.
+ * @since  3.1.0 [2026-10-17-12:00pm] New.
+ * @since  3.1.1 [2026-10-18-05:00am] Invariant header only (no longer on the per-frame path).
+ * @see    recorderRecover().
+ */
+uint32_t recorderCheck() {
+    const uint32_t * w = (const uint32_t *) &flightRec;
+          uint32_t   c = 0x5a5a5a5a;
+    for (size_t i = 0; i < offsetof(flightRecorder, check) / sizeof(uint32_t); i++) {
+        c = ((c << 5) | (c >> 27)) ^ w[i];
+    }
+    return ((c << 5) | (c >> 27)) ^ (uint32_t) sizeof(flightRecorder);
+}
+
+/**
+ * ------------------------------------------------
+ *      Flight recorder counters plausible?
+ * ------------------------------------------------
+ *
+ * Counters are bumped one at a time (framesIn first), so a reset between two stores still passes.
+ *
+ * @param  const flightCounters * c Counters.
+ * @return bool True if frames out, decimated & CRC errors fit within frames in.
+ * @since  3.1.1 [2026-10-18-05:00am] New.
+ * @see    recorderRecover().
+ */
+bool recorderPlausible(const flightCounters * c) {
+    return ((uint64_t) c->framesOut + c->decimated <= c->framesIn) && (c->crcErrors <= c->framesIn);
+}
+
+/**
+ * ------------------------------------------------
+ *      Serial0 receive error callback.
+ * ------------------------------------------------
+ *
+ * Runs in the HardwareSerial event task.
+ *
+ * @param  hardwareSerial_error_t error UART error.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-01:30pm] New.
+ * @see    startSerial().
+ */
+void onSerial0Error(hardwareSerial_error_t error) {
+    if ((error == UART_BUFFER_FULL_ERROR) || (error == UART_FIFO_OVF_ERROR)) {
+        flightRec.now.rxOverflows++;
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Serial0 RX event (arrival timestamp).
+ * ------------------------------------------------
+ *
+ * Runs in the HardwareSerial event task, which the UART ISR wakes on FIFO full (RX_FIFO_FULL bytes) or RX timeout
+ * (RX_TIMEOUT_SYM quiet symbols) & which preempts loop(). Marks "bytes up to end were in by at". Back to back
+ * FIFO full events should be count byte times apart; the difference is event latency jitter, part of the error bound.
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-02:30am] New.
+ * @see    rxByteTime().
+ */
+void onSerial0Rx() {
+
+    // -- Local vars. --
+    int64_t  at  = esp_timer_get_time();
+    uint32_t end = rxTs.readIdx + Serial0.available();
+    rxMark * m;
+    rxMark * prev;
+    uint32_t dev;
+
+    taskENTER_CRITICAL(&rxTsMux);
+    prev = &rxTs.marks[(rxTs.head + RX_MARKS - 1) % RX_MARKS];
+    if (end != prev->end) {                                         // New bytes (queued events can find none).
+        m        = &rxTs.marks[rxTs.head];
+        m->count = (uint16_t) ((end > prev->end) ? end - prev->end : end - rxTs.readIdx);   // Re-init dropped bytes.
+        m->end   = end;
+        m->at    = at;
+        if ((prev->count >= RX_FIFO_FULL) && (m->count >= RX_FIFO_FULL) &&
+            (at - prev->at < 2 * m->count * rxTs.byteUs)) {             // Same burst.
+            dev = (uint32_t) llabs((at - prev->at) - m->count * rxTs.byteUs);
+            rxTs.jitterMax  = max(rxTs.jitterMax, dev);
+            rxTs.jitterAvg += ((int32_t) dev - (int32_t) rxTs.jitterAvg) / 16;
+        }
+        rxTs.head = (rxTs.head + 1) % RX_MARKS;
+    }
+    rxTs.events++;
+    taskEXIT_CRITICAL(&rxTsMux);
 }
 
 /**
@@ -180,27 +1249,132 @@ void showBuild() {
  *      Start serial interfaces.
  * ------------------------------------------------
  * 
+ * The radio path comes up first: ZED UART, then HC-12, then USB. Nothing is printed here - the banner is deferred
+ * to loop() so no RTCM3 byte waits behind USB output. Serial0's RX buffer is sized to hold the boot burst.
+ *
  * @return void No output is returned.
  * @since  3.0.9  [2025-12-14-02:00pm] New.
  * @since  3.0.10 [2025-12-30-02:00pm] Add Serial USB.
+ * @since  3.1.0  [2026-10-17-11:00am] Radio path first, no printing.
+ * @since  3.1.0  [2026-10-17-01:30pm] Serial0 overflow callback.
+ * @since  3.1.0  [2026-10-17-08:00pm] Speeds from config.
+ * @since  3.1.0  [2026-10-17-10:00pm] TX rings, LP UART second radio.
+ * @since  3.1.0  [2026-10-17-11:00pm] Serial0/1 start split out (watchdog re-init).
+ * @since  3.1.1  [2026-10-18-01:30am] Role; receiver Serial0 TX ring.
+ * @since  3.1.1  [2026-10-18-02:30am] Serial0 RX events (arrival timestamps).
+ * @since  3.1.1  [2026-10-18-04:30am] ZED speed detection.
+ * @since  3.1.1  [2026-10-18-05:00am] HC-12 speed kept in radioSpeed (a pending cfg serial1 waits for reboot).
+ * @since  3.1.1  [2026-10-18-05:00am] Repeater without a 2nd radio starts as receiver.
  * @see    setup().
  * @link   https://randomnerdtutorials.com/esp32-uart-communication-serial-arduino/#esp32-custom-uart-pins.
  */
 void startSerial() {
 
-    // --- Serial interface. ---
-    Serial.println("\nSetup() started.");
-    Serial.printf("Serial (USB) started @ %i bps.\n", SERIAL_USB_SPEED);
-
     // --- Serial0 interface. ---
-    Serial.printf("Serial0 (ZED) started @ %i bps", SERIAL0_SPEED);
-    Serial0.begin(SERIAL0_SPEED, SERIAL_8N1, RTCM_IN, RTCM_OUT);     // UART0 object. RX, TX.
-    Serial.println(".");
+    role      = (relayRole) config.role;
+    if ((role == ROLE_REPEATER) && !(RADIO2_BUILD && (config.radio2 != RADIO2_OFF))) {
+        role = ROLE_RECEIVER;                                       // No 2nd radio - listen only (see configValid()).
+    }
+    baud.rate = config.serial0Speed;
+    startSerial0();
+    if ((role == ROLE_RELAY) && config.autobaud) {                  // Check the ZED speed (relays at the last good one).
+        baudScan(true);
+    }
+    bootMark(BOOT_SERIAL0);
 
     // --- Serial1 interface. ---
-    Serial.printf("Serial1 (HC-12) started @ %i bps", SERIAL1_SPEED);
-    Serial1.begin(SERIAL1_SPEED, SERIAL_8N1, HC12_RX, HC12_TX);     // UART1 object. RX, TX.
-    Serial.println(".");
+    radioSpeed  = config.serial1Speed;                              // Airtime model & budgets use this, not config.
+    radioByteUs = 10 * 1000000 / (int64_t) radioSpeed;
+    startSerial1();
+#if GR_RADIO2
+    SerialLP.setTxBufferSize(RADIO_TX_BUF);
+    SerialLP.begin(radioSpeed, SERIAL_8N1, HC12B_RX, HC12B_TX);   // LP UART. Same speed as the HC-12.
+#endif
+    bootMark(BOOT_SERIAL1);
+
+    // --- Serial interface. ---
+    Serial.begin(SERIAL_USB_SPEED);
+}
+
+/**
+ * ------------------------------------------------
+ *      Start Serial0 (ZED).
+ * ------------------------------------------------
+ *
+ * RX ring, error & receive callbacks (overflow count, arrival timestamps), then the RX FIFO threshold & timeout,
+ * which need the driver begin() installs. Receiver role: a TX ring for whole frames out to the GNSS.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:00pm] New. From startSerial().
+ * @since  3.1.1 [2026-10-18-04:30am] Serial0 at the detected speed (baud.rate).
+ * @see    startSerial().
+ * @see    restartSerial0().
+ */
+void startSerial0() {
+    Serial0.setRxBufferSize(SERIAL0_RX_BUF);
+    if (role == ROLE_RECEIVER) {
+        Serial0.setTxBufferSize(RADIO_TX_BUF);                      // Whole frames out to the GNSS.
+    }
+    Serial0.onReceiveError(onSerial0Error);                         // Count overflows.
+    Serial0.onReceive(onSerial0Rx);                                 // Arrival timestamps.
+    Serial0.begin(baud.rate, SERIAL_8N1, RTCM_IN, RTCM_OUT);        // UART0 object. RX, TX.
+    Serial0.setRxFIFOFull(RX_FIFO_FULL);                            // After begin() - needs the driver.
+    Serial0.setRxTimeout(RX_TIMEOUT_SYM);
+    rxTs.byteUs = 10 * 1000000 / (int64_t) baud.rate;
+}
+
+/**
+ * ------------------------------------------------
+ *      Start Serial1 (HC-12).
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:00pm] New. From startSerial().
+ * @since  3.1.1 [2026-10-18-05:00am] At radioSpeed (set once in startSerial()).
+ * @see    startSerial().
+ * @see    restartSerial1().
+ */
+void startSerial1() {
+    Serial1.setTxBufferSize(RADIO_TX_BUF);
+    Serial1.begin(radioSpeed, SERIAL_8N1, HC12_RX, HC12_TX);        // UART1 object. RX, TX.
+}
+
+/**
+ * ------------------------------------------------
+ *      Restart Serial0 (ZED) in place.
+ * ------------------------------------------------
+ *
+ * Watchdog recovery without end() / begin(), which would free & re-allocate the UART driver, its ring buffers &
+ * event queue in steady state (heap fragmentation). The driver stays installed: RX FIFO & ring buffer are reset,
+ * RX interrupts re-enabled (a wedged driver or "wdog rx" leaves them off) & the divisor re-programmed.
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-05:00am] New.
+ * @see    checkWatchdog().
+ */
+void restartSerial0() {
+    uart_flush_input(UART_NUM_0);                                   // RX FIFO & ring buffer reset.
+    uart_enable_rx_intr(UART_NUM_0);
+    Serial0.updateBaudRate(baud.rate);
+    rxTs.byteUs = 10 * 1000000 / (int64_t) baud.rate;
+}
+
+/**
+ * ------------------------------------------------
+ *      Restart Serial1 (HC-12) in place.
+ * ------------------------------------------------
+ *
+ * Watchdog recovery as restartSerial0(): the driver, its TX ring buffer & event queue stay installed. The TX empty
+ * interrupt that feeds the FIFO from the ring is re-enabled (a wedged driver or "wdog tx" leaves it off) & the
+ * divisor re-programmed; bytes still in the ring then drain.
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-06:30am] New.
+ * @see    checkWatchdog().
+ */
+void restartSerial1() {
+    uart_enable_tx_intr(UART_NUM_1, 1, 10);                         // Driver's default empty threshold.
+    Serial1.updateBaudRate(radioSpeed);
 }
 
 /**
@@ -213,24 +1387,95 @@ void startSerial() {
  * @see    setup().
  */
 void initVars() {
-    Serial.print("Init global vars");
 
     // --- I/O. ---
     serialChar = '\0';
     memset(monitorCommand, '\0', sizeof(monitorCommand));
     memset(radioCommand,   '\0', sizeof(radioCommand));
     memset(rtcmSentence,   '\0', sizeof(rtcmSentence));
+    radioAirUntil = 0;
+    memset(radioLinkUntil, 0, sizeof(radioLinkUntil));
+    memset(radioLinkBytes, 0, sizeof(radioLinkBytes));
+    memset(gnssLink, LINK_1, sizeof(gnssLink));
+    rtcmRoute     = LINK_BOTH;
+    rtcmResync    = false;
+    memset(&wdog, 0, sizeof(wdog));
+    memset(&hop, 0, sizeof(hop));
+    memset(&bin, 0, sizeof(bin));
+    rxClear();
+    memset(&rxTs, 0, sizeof(rxTs));
+    rtcmStationId = 0;
+    rtcmInFrame   = false;
+    rtcmLastByte  = 0;
+    rtcmRx        = {(uint8_t *) rtcmSentence, 0, 0, 0};
+    initCrc24q();                                               // CRC-24Q & CRC-16 tables.
+    recorderRecover();                                          // Flight recorder.
 
     // --- Operation. ---
     inLoop  = false;
 
+    // --- Task monitor. ---
+    memset(taskMon,      0, sizeof(taskMon));
+    memset(taskMonWork,  0, sizeof(taskMonWork));
+    memset(taskMonTotal, 0, sizeof(taskMonTotal));
+    memset(taskMonLoops, 0, sizeof(taskMonLoops));
+    taskMonLoopRateMin = 0;
+    taskMonHead        = 0;
+    taskMonSamples     = 0;
+    loopCount          = 0;
+    radioRtcmLEDwakes  = 0;
+    taskMonitorWakes   = 0;
+
+    // --- Heap tracking. ---
+    heapNewCount   = 0;
+    heapNewBytes   = 0;
+    heapAllocCount = 0;
+    heapAllocBytes = 0;
+    heapFreeCount  = 0;
+    heapWarned     = false;
+
     // --- Commands. ---
     testLEDr = false;
     testRad  = false;
     debugRad = false;
     reset    = false;
 
-    Serial.println(".");
+    // --- Boot. ---
+    bootFirstAir      = 0;
+    bootBannerShown   = false;
+
+    // --- Telemetry. ---
+    memset(telemText, '\0', sizeof(telemText));
+    telemSeq         = 0;
+    telemLast        = 0;
+    telemAirBusy     = 0;
+    telemRxHighWater = 0;
+    telemStall       = 0;
+
+    // --- Decimation. ---
+    memset(&decim, 0, sizeof(decim));
+    decim.enabled  = true;
+    decim.periodMs = 1000;
+    for (size_t i = 0; i < GNSS_NUM; i++) {
+        decim.ratio[i] = 1;
+    }
+    memset(&profile, 0, sizeof(profile));
+    memset(&fcast, 0, sizeof(fcast));
+
+    // --- Latency. ---
+    memset(latStats, 0, sizeof(latStats));
+    latHead        = 0;
+    latCount       = 0;
+    latOffset      = 0;
+    rtcmFrameEpoch = -1;
+
+    // --- Power. ---
+    memset(&power, 0, sizeof(power));
+    power.mode = POWER_RUN;
+
+    // --- Update. ---
+    memset(&update, 0, sizeof(update));
+    update.stage = UPDATE_IDLE;
 }
 
 /**
@@ -243,12 +1488,10 @@ void initVars() {
  * @see    setup().
  */
 void initPins() {
-    Serial.print("Init pins");
     pinMode(HC12_SET,  OUTPUT);                 // HC-12 - set pin for AT command mode.
     digitalWrite(HC12_SET,  HIGH);              // HC-12 - initially set pin for transparent mode.
     pinMode(LED_RADIO, OUTPUT);
     digitalWrite(LED_RADIO, LOW);
-    Serial.println(".");
 }
 
 /**
@@ -275,16 +1518,23 @@ void startI2c() {
  *
  * @return void No output is returned.
  * @since  3.0.9 [2025-12-14-02:00pm] New.
+ * @since  3.1.0 [2026-10-17-09:30am] Add task monitor.
+ * @since  3.1.0 [2026-10-17-10:15am] Static stacks & TCBs (no heap).
  * @see    Global vars: Task handles.
+ * @see    Global vars: Task memory.
  * @see    setup().
- * @link   https://www.freertos.org/Documentation/02-Kernel/04-API-references/01-Task-creation/01-xTaskCreate.
+ * @link   https://www.freertos.org/Documentation/02-Kernel/04-API-references/01-Task-creation/02-xTaskCreateStatic.
  */
 void startTasks() {
 
     // -- RTCM SEND status LED. --
-    xTaskCreate(radioRtcmLEDtask,    "radio_RTCM_LED_task",       2048, NULL, 2, &radioRtcmLEDtaskHandle);
+    radioRtcmLEDtaskHandle = xTaskCreateStatic(radioRtcmLEDtask, "radio_RTCM_LED_task", RADIO_LED_TASK_STACK, NULL, 2,
+                                               radioRtcmLEDtaskStack, &radioRtcmLEDtaskTCB);
     vTaskSuspend(radioRtcmLEDtaskHandle);
-    Serial.println("Task started: \"RTCM SEND status LED\".");
+
+    // -- Task monitor (CPU & stack sampler). --
+    taskMonitorTaskHandle  = xTaskCreateStatic(taskMonitorTask,  "task_monitor_task",   TASK_MON_TASK_STACK,  NULL, 2,
+                                               taskMonitorTaskStack,  &taskMonitorTaskTCB);
 }
 
 /**
@@ -292,14 +1542,24 @@ void startTasks() {
  *      Start loop().
  * ------------------------------------------------
  *
+ * Everything the relay needs is allocated by now (UART ring buffers are allocated by begin()). The heap is
+ * snapshotted here so heapSample() can report any steady state allocation.
+ *
  * @return void  No output is returned.
  * @since  3.0.9 [2025-12-14-02:00pm] New.
+ * @since  3.1.0 [2026-10-17-10:15am] Heap snapshot.
+ * @since  3.1.0 [2026-10-17-11:00am] Banner deferred to checkBootBanner().
  * @see    setup().
  */
 void startLoop() {
     updateLED('0');     // RTCM LED off.
+    heap_caps_get_info(&heapInfo, MALLOC_CAP_DEFAULT);
+    heapLoopBlocks = heapInfo.allocated_blocks;
+    heapLoopFree   = heapInfo.total_free_bytes;
+    heapPeakBlocks = heapInfo.allocated_blocks;
+    heapMinLargest = heapInfo.largest_free_block;
     inLoop = true;
-    Serial.println("Loop() started.\n");
+    bootMark(BOOT_LOOP);
 }   
 
 /**
@@ -308,6 +1568,7 @@ void startLoop() {
  * ============================================================================
  * @see startTasks()              - Start tasks.
  *   @see radioRtcmLEDtask()      - Radio active LED.
+ *   @see taskMonitorTask()       - Task CPU & stack sampler.
  */
 
 /**
@@ -324,6 +1585,7 @@ void startLoop() {
  */
 void radioRtcmLEDtask(void * pvParameters) {
     while(true) {
+        radioRtcmLEDwakes++;                // Count wake-ups.
         digitalWrite(LED_RADIO, HIGH);      // LED on.
         vTaskDelay(LED_TIME_FLASH_ON);      // LED remains on (ms).
         digitalWrite(LED_RADIO, LOW);       // LED off.
@@ -331,46 +1593,251 @@ void radioRtcmLEDtask(void * pvParameters) {
     }
 }
 
-/**
- * ============================================================================
- *                          Loop functions.
- * ============================================================================
- */
-
 /**
  * ------------------------------------------------
- *      Check serial USB for input.
+ *      Task - Task CPU & stack sampler.
  * ------------------------------------------------
  *
+ * Once per TASK_MON_PERIOD, snapshot every task with uxTaskGetSystemState() and push its run time counter into a
+ * ring of TASK_MON_WINDOW samples. CPU % is computed on demand (showTasks()) from the ring ends, so each sample is
+ * only a copy - no division or printing here. Warns once per task when the stack high-water mark drops below
+ * TASK_MON_STACK_LOW, and tracks the lowest loop() pass rate so overload shows up before bytes start dropping.
+ * Matching, names & history are built in taskMonWork with interrupts on; the critical section only publishes it
+ * (one copy) with the ring heads, so it adds little interrupt latency.
+ *
+ * @param  void * pvParameters Pointer to task parameters.
  * @return void No output is returned.
- * @since  3.0.9 [2025-12-17-06:00pm] New.
- * @since  3.0.10 [2025-12-30-06:45pm] Refactor.
- * @see    loop().
+ * @since  3.1.0 [2026-10-17-09:30am] New.
+ * @since  3.1.1 [2026-10-18-06:30am] Work copy - no search or string copy inside the critical section.
+ * @see    startTasks().
+ * @see    showTasks().
+ * @link   https://www.freertos.org/Documentation/02-Kernel/04-API-references/03-Task-utilities/00-Task-utilities#uxtaskgetsystemstate.
  */
-// void checkSerialUSBold() {  // ToDo: delete after testing new version.
+void taskMonitorTask(void * pvParameters) {
 
-//     // --- Local vars. ---
-//     static char    monitorCommand[11];
-//     static char    monitorBuffer[50];                               // Serial monitor buffer (C-string).
-//     static uint8_t posn                = 0;                         // Input position for USB serial monitor command.
-//     static uint8_t posnRad             = 0;                         // Input position for radio test command.
-//            char    incomingByte;
-//            uint8_t whichMonitorCommand = 0;                         // Which command was entered from the USB serial monitor.
+    // --- Local vars. ---
+    TickType_t  lastWake = xTaskGetTickCount();
+    UBaseType_t numTasks;
+    uint32_t    totalRunTime;
+    uint32_t    loops;
+    uint32_t    loopRate;
+    uint32_t    cpu;
+    uint8_t     head;
+    uint8_t     prev;
+    size_t      i;
+    size_t      j;
 
-//     // --- Read bytes. ---
-//     if (Serial.available() > 0) {
-//         incomingByte = Serial.read();
+    while (true) {
+        vTaskDelayUntil(&lastWake, TASK_MON_PERIOD);
+        taskMonitorWakes++;
+        numTasks = uxTaskGetSystemState(taskMonStatus, TASK_MON_MAX_TASKS, &totalRunTime);
+        loops    = loopCount;
 
-//         // -- Process input buffer. --
-//         if ((incomingByte == '\n') || (incomingByte == '\r'))  {
-//             memset(monitorCommand, '\0', sizeof(monitorCommand));
-//             strncpy(monitorCommand, monitorBuffer, posn);
-//             posn = 0;
-//             memset(monitorBuffer, '\0', sizeof(monitorBuffer));
-//             if (strstr(monitorCommand,"?") != NULL) {                                       // List commands.
-//                 Serial.print("\nValid commands: ");
-//                 for (size_t i = 0; i < NUM_COMMANDS-1; i++) {                               // Loop command array.
-//                     if ((i != 0) && (i % 7 == 0)) {                                         // List a max of (7) commands per line.
+        prev = taskMonHead;                                                         // Only writer - no lock to read.
+        head = (taskMonHead + 1) % (TASK_MON_WINDOW + 1);
+        for (j = 0; j < TASK_MON_MAX_TASKS; j++) {
+            taskMonWork[j].alive = false;
+        }
+        for (i = 0; i < numTasks; i++) {
+            for (j = 0; j < TASK_MON_MAX_TASKS; j++) {                              // Find tracked entry.
+                if (taskMonWork[j].name[0] != '\0' && taskMonWork[j].taskNumber == taskMonStatus[i].xTaskNumber) {
+                    break;
+                }
+            }
+            if (j == TASK_MON_MAX_TASKS) {                                          // New task - claim a free slot.
+                for (j = 0; j < TASK_MON_MAX_TASKS; j++) {
+                    if (taskMonWork[j].name[0] == '\0') {
+                        taskMonWork[j].taskNumber = taskMonStatus[i].xTaskNumber;
+                        strncpy(taskMonWork[j].name, taskMonStatus[i].pcTaskName, sizeof(taskMonWork[j].name) - 1);
+                        for (size_t k = 0; k <= TASK_MON_WINDOW; k++) {             // No history yet.
+                            taskMonWork[j].runTime[k] = taskMonStatus[i].ulRunTimeCounter;
+                        }
+                        break;
+                    }
+                }
+            }
+            if (j == TASK_MON_MAX_TASKS) {                                          // Table full.
+                continue;
+            }
+            taskMonWork[j].runTime[head]  = taskMonStatus[i].ulRunTimeCounter;
+            taskMonWork[j].stackHighWater = taskMonStatus[i].usStackHighWaterMark;
+            taskMonWork[j].priority       = taskMonStatus[i].uxCurrentPriority;
+            taskMonWork[j].state          = taskMonStatus[i].eCurrentState;
+            taskMonWork[j].alive          = true;
+            if (totalRunTime != taskMonTotal[prev]) {                               // Peak single-sample CPU.
+                cpu = (uint32_t) (((uint64_t) (taskMonWork[j].runTime[head] - taskMonWork[j].runTime[prev]) * 1000) /
+                                  (totalRunTime - taskMonTotal[prev]));
+                taskMonWork[j].cpuPeak = max(taskMonWork[j].cpuPeak, cpu);
+            }
+        }
+        for (j = 0; j < TASK_MON_MAX_TASKS; j++) {                                  // Free slots of deleted tasks.
+            if (!taskMonWork[j].alive) {
+                memset(&taskMonWork[j], 0, sizeof(taskMonWork[j]));
+            }
+        }
+        loopRate = (loops - taskMonLoops[prev]) * 1000 / (TASK_MON_PERIOD * portTICK_PERIOD_MS);
+
+        taskENTER_CRITICAL(&taskMonMux);                                            // Publish: copies only.
+        memcpy(taskMon, taskMonWork, sizeof(taskMon));
+        taskMonTotal[head] = totalRunTime;
+        taskMonLoops[head] = loops;
+        if (taskMonSamples > 0) {
+            taskMonLoopRateMin = (taskMonSamples == 1) ? loopRate : min(taskMonLoopRateMin, loopRate);
+        }
+        taskMonHead    = head;
+        taskMonSamples = min(taskMonSamples + 1, TASK_MON_WINDOW + 1);
+        taskEXIT_CRITICAL(&taskMonMux);
+
+        heapSample();                                                               // Heap tracking.
+
+        // -- Low stack warning (once per task). --
+        for (j = 0; j < TASK_MON_MAX_TASKS; j++) {
+            taskMonEntry * t = &taskMonWork[j];
+            if (t->alive && !t->stackWarned && (t->stackHighWater < TASK_MON_STACK_LOW)) {
+                t->stackWarned = true;
+                Serial.printf("\nWarning: task \"%s\" stack high-water %lu bytes.\n",
+                              t->name, (unsigned long) t->stackHighWater);
+            }
+        }
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Count heap allocations.
+ * ------------------------------------------------
+ *
+ * Replaces the global operator new so any C++ allocation made after startLoop() is counted. The default
+ * operator delete (free()) still pairs with it.
+ *
+ * @param  size_t size Bytes requested.
+ * @return void * Allocated block.
+ * @since  3.1.0 [2026-10-17-10:15am] New.
+ * @see    showHeap().
+ */
+void * operator new(size_t size) {
+    void * block = malloc(size);
+    if (inLoop) {
+        heapNewCount++;
+        heapNewBytes += size;
+    }
+    if (block == NULL) {
+        abort();                                // Out of memory.
+    }
+    return block;
+}
+
+#ifdef CONFIG_HEAP_USE_HOOKS
+/**
+ * ------------------------------------------------
+ *      Count heap allocations (IDF heap hook).
+ * ------------------------------------------------
+ *
+ * Called by the heap for every malloc / heap_caps_* / pvPortMalloc, so allocations made by HardwareSerial, the UART
+ * driver & FreeRTOS are counted too, not only C++ new. Can run from any task with the heap locked - counts only.
+ *
+ * @param  void *   ptr  Block.
+ * @param  size_t   size Bytes requested.
+ * @param  uint32_t caps Capabilities.
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-05:00am] New.
+ * @see    heapSample().
+ */
+void IRAM_ATTR esp_heap_trace_alloc_hook(void * ptr, size_t size, uint32_t caps) {
+    if (inLoop && (ptr != NULL)) {
+        heapAllocCount++;
+        heapAllocBytes += size;
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Count heap frees (IDF heap hook).
+ * ------------------------------------------------
+ *
+ * Pairs with esp_heap_trace_alloc_hook(); same rules - any task, heap locked, counts only.
+ *
+ * @param  void * ptr Block.
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-05:00am] New.
+ * @see    heapSample().
+ */
+void IRAM_ATTR esp_heap_trace_free_hook(void * ptr) {
+    if (inLoop && (ptr != NULL)) {
+        heapFreeCount++;
+    }
+}
+#endif
+
+/**
+ * ------------------------------------------------
+ *      Sample heap.
+ * ------------------------------------------------
+ *
+ * Called by the task monitor once per sample. Tracks allocated block peak & largest free block (fragmentation)
+ * since startLoop(), and warns once if the steady state relay has allocated - by new, by the heap hooks (any
+ * allocation, even one freed again) or by the allocated block count.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-10:15am] New.
+ * @since  3.1.1 [2026-10-18-05:00am] Heap hook count.
+ * @see    taskMonitorTask().
+ */
+void heapSample() {
+    if (!inLoop) {
+        return;
+    }
+    heap_caps_get_info(&heapInfo, MALLOC_CAP_DEFAULT);
+    heapPeakBlocks = max(heapPeakBlocks, heapInfo.allocated_blocks);
+    heapMinLargest = min(heapMinLargest, heapInfo.largest_free_block);
+    if (!heapWarned && ((heapNewCount > 0) || (heapAllocCount > 0) || (heapInfo.allocated_blocks > heapLoopBlocks))) {
+        heapWarned = true;
+        Serial.printf("\nWarning: heap allocation after loop() started (new: %lu, alloc: %lu, blocks: %+ld).\n",
+                      (unsigned long) heapNewCount, (unsigned long) heapAllocCount,
+                      (long) heapInfo.allocated_blocks - (long) heapLoopBlocks);
+    }
+}
+
+/**
+ * ============================================================================
+ *                          Loop functions.
+ * ============================================================================
+ */
+
+/**
+ * ------------------------------------------------
+ *      Check serial USB for input.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.0.9 [2025-12-17-06:00pm] New.
+ * @since  3.0.10 [2025-12-30-06:45pm] Refactor.
+ * @see    loop().
+ */
+// void checkSerialUSBold() {  // ToDo: delete after testing new version.
+
+//     // --- Local vars. ---
+//     static char    monitorCommand[11];
+//     static char    monitorBuffer[50];                               // Serial monitor buffer (C-string).
+//     static uint8_t posn                = 0;                         // Input position for USB serial monitor command.
+//     static uint8_t posnRad             = 0;                         // Input position for radio test command.
+//            char    incomingByte;
+//            uint8_t whichMonitorCommand = 0;                         // Which command was entered from the USB serial monitor.
+
+//     // --- Read bytes. ---
+//     if (Serial.available() > 0) {
+//         incomingByte = Serial.read();
+
+//         // -- Process input buffer. --
+//         if ((incomingByte == '\n') || (incomingByte == '\r'))  {
+//             memset(monitorCommand, '\0', sizeof(monitorCommand));
+//             strncpy(monitorCommand, monitorBuffer, posn);
+//             posn = 0;
+//             memset(monitorBuffer, '\0', sizeof(monitorBuffer));
+//             if (strstr(monitorCommand,"?") != NULL) {                                       // List commands.
+//                 Serial.print("\nValid commands: ");
+//                 for (size_t i = 0; i < NUM_COMMANDS-1; i++) {                               // Loop command array.
+//                     if ((i != 0) && (i % 7 == 0)) {                                         // List a max of (7) commands per line.
 //                         Serial.println();
 //                     }
 //                     Serial.printf("%s, ", COMMANDS[i]);
@@ -517,19 +1984,30 @@ void radioRtcmLEDtask(void * pvParameters) {
  * @return void No output is returned.
  * @since  3.0.9  [2025-12-17-06:00pm] New.
  * @since  3.0.10 [2025-12-30-01:15pm] Refactor.
+ * @since  3.1.0  [2026-10-17-05:00pm] Debug & test commands gated by GR_DEBUG.
+ * @since  3.1.0  [2026-10-17-08:00pm] Command arguments.
+ * @since  3.1.0  [2026-10-17-11:59pm] Binary (COBS) frames & BIN_CMD commands.
  * @see    loop().
  */
 void checkSerialUSB() {
 
     // --- Local vars. ---
-    static char   command[11];                                                  // Command buffer.
+    static char   command[41];                                                  // Command buffer (command & arguments).
+           char * args;                                                         // Command arguments.
     static size_t posn         = 0;                                             // Input position for command buffer.
            size_t i            = 0;                                             // Command array elementcounter.
            size_t whichCommand = 0;                                             // Command array element matched.
 
     // --- Process input. ---
-    if (Serial.available() > 0) {
-        serialChar = Serial.read();                                             // Read char from USB Serial.
+    if ((bin.inject[bin.injectPos] != '\0') || (Serial.available() > 0)) {
+        if (bin.inject[bin.injectPos] != '\0') {                                 // Command from a BIN_CMD request.
+            serialChar = bin.inject[bin.injectPos++];
+        } else {
+            serialChar = Serial.read();                                         // Read char from USB Serial.
+            if (binByte((uint8_t) serialChar)) {                                // Binary frame byte.
+                return;
+            }
+        }
         if ((serialChar == '\n') || (serialChar == '\r'))  {                    // Possible command.
             if (posn > 0) {                                                     // Character(s) have been read from serial USB.
                 if (strstr(command,"?") != NULL) {                              // List commands.
@@ -550,22 +2028,32 @@ void checkSerialUSB() {
                 } else {
                     size_t i            = 0;
                     size_t whichCommand = 100;                                                  // Which command was entered?
+                    args = strchr(command, ' ');                                                // Split off arguments.
+                    if (args != NULL) {
+                        *args++ = '\0';
+                    }
                     while ((whichCommand == 100) && (i < NUM_COMMANDS)) {
                         if (strcmp(command,COMMANDS[i]) == 0) {                                 // Match a valid command.
                             switch (i) {
                                 case 0:                                                         // Test the RTCM sentence relay LED.
-                                    testLEDr = (testLEDr == true) ? false : true;               // Flip the debug flag.
-                                    Serial.printf("%s %s\n", COMMANDS[i], (testLEDr ? "enabled." : "disabled."));
+                                    if (debugAvailable(COMMANDS[i])) {
+                                        testLEDr = (testLEDr == true) ? false : true;           // Flip the debug flag.
+                                        Serial.printf("%s %s\n", COMMANDS[i], (testLEDr ? "enabled." : "disabled."));
+                                    }
                                     whichCommand = i;
                                     break;
                                 case 1:                                                         // Test/config the radio.
-                                    testRad = (testRad == true) ? false : true;                 // Flip the debug flag.
-                                    Serial.printf("%s %s\n", COMMANDS[i], (testRad ? "enabled." : "disabled."));
+                                    if (debugAvailable(COMMANDS[i])) {
+                                        testRad = (testRad == true) ? false : true;             // Flip the debug flag.
+                                        Serial.printf("%s %s\n", COMMANDS[i], (testRad ? "enabled." : "disabled."));
+                                    }
                                     whichCommand = i;
                                     break;
                                 case 2:                                                         // Display data from radio.
-                                    debugRad = (debugRad == true) ? false : true;               // Flip the debug flag.
-                                    Serial.printf("%s %s\n", COMMANDS[i], (debugRad ? "enabled." : "disabled."));
+                                    if (debugAvailable(COMMANDS[i])) {
+                                        debugRad = (debugRad == true) ? false : true;           // Flip the debug flag.
+                                        Serial.printf("%s %s\n", COMMANDS[i], (debugRad ? "enabled." : "disabled."));
+                                    }
                                     whichCommand = i;
                                     break;
                                 case 3:                                                         // Reset MCU.
@@ -574,6 +2062,123 @@ void checkSerialUSB() {
                                     Serial.println("Restarting ...");
                                     whichCommand = i;
                                     esp_restart();                                              // Reset MCU.
+                                case 4:                                                         // Task CPU & stack report.
+                                    showTasks();
+                                    whichCommand = i;
+                                    break;
+                                case 5:                                                         // Heap report.
+                                    showHeap();
+                                    whichCommand = i;
+                                    break;
+                                case 6:                                                         // Boot timeline.
+                                    showBoot();
+                                    whichCommand = i;
+                                    break;
+                                case 7:                                                         // Flight recorder.
+                                    showRecorder();
+                                    whichCommand = i;
+                                    break;
+                                case 8:                                                         // Telemetry.
+                                    showTelemetry();
+                                    whichCommand = i;
+                                    break;
+                                case 9:                                                         // Epoch decimation.
+                                    decim.enabled = (decim.enabled == true) ? false : true;     // Flip the flag.
+                                    Serial.printf("%s %s\n", COMMANDS[i], (decim.enabled ? "enabled." : "disabled."));
+                                    showDecimation();
+                                    whichCommand = i;
+                                    break;
+                                case 10:                                                        // Epoch to air latency.
+                                    showLatency();
+                                    whichCommand = i;
+                                    break;
+                                case 11:                                                        // Power mode (cycle).
+                                    setPowerMode((powerMode) ((power.mode + 1) % POWER_MODES));
+                                    showPower();
+                                    whichCommand = i;
+                                    break;
+                                case 12:                                                        // Firmware update (tools/usb_update.py).
+                                    startUpdate();
+                                    whichCommand = i;
+                                    break;
+                                case 13:                                                        // Config: cfg [name value | commit | default].
+                                    configCommand(args);
+                                    whichCommand = i;
+                                    break;
+                                case 14:                                                        // Bit field self test & timing.
+                                    bitsTest();
+                                    whichCommand = i;
+                                    break;
+                                case 15:                                                        // Second radio mode (cycle).
+                                    if (RADIO2_BUILD) {
+                                        config.radio2 = (config.radio2 + 1) % RADIO2_MODES;
+                                        if (!configValid(&config)) {                            // Repeater: skip off.
+                                            config.radio2 = (config.radio2 + 1) % RADIO2_MODES;
+                                        }
+                                    }
+                                    showRadio();
+                                    whichCommand = i;
+                                    break;
+                                case 16:                                                        // Watchdog: wdog [rx | tx] (fault injection).
+                                    if ((args != NULL) && (strcmp(args, "rx") == 0)) {
+                                        uart_disable_rx_intr(UART_NUM_0);                       // ZED input wedged.
+                                        Serial.println("wdog: Serial0 RX interrupts off.");
+                                    } else if ((args != NULL) && (strcmp(args, "tx") == 0)) {
+                                        uart_disable_tx_intr(UART_NUM_1);                       // HC-12 output wedged.
+                                        Serial.println("wdog: Serial1 TX interrupts off.");
+                                    } else {
+                                        showWatchdog();
+                                    }
+                                    whichCommand = i;
+                                    break;
+                                case 17:                                                        // Radio hop encoding & saving.
+                                    showHop();
+                                    whichCommand = i;
+                                    break;
+                                case 18:                                                        // Kernel bench: bench [pause].
+                                    benchRun((args != NULL) && (strcmp(args, "pause") == 0));
+                                    whichCommand = i;
+                                    break;
+                                case 19:                                                        // Hot path & flash ops: hot [clear].
+                                    if ((args != NULL) && (strcmp(args, "clear") == 0)) {
+                                        hotClear();
+                                    }
+                                    showHot();
+                                    whichCommand = i;
+                                    break;
+                                case 20:                                                        // Receiver role stats: rx [clear].
+                                    if ((args != NULL) && (strcmp(args, "clear") == 0)) {
+                                        rxClear();
+                                    }
+                                    showRx();
+                                    whichCommand = i;
+                                    break;
+                                case 21:                                                        // Self test: selftest [loop].
+                                    selfTestStart(((args != NULL) && (strcmp(args, "loop") == 0)) ? ST_LOOPBACK
+                                                                                                  : ST_INTERNAL);
+                                    whichCommand = i;
+                                    break;
+                                case 22:                                                        // Base profile: profile [clear].
+                                    if ((args != NULL) && (strcmp(args, "clear") == 0)) {
+                                        profileClear();
+                                    }
+                                    showProfile();
+                                    whichCommand = i;
+                                    break;
+                                case 23:                                                        // Epoch forecast: fcast [clear].
+                                    if ((args != NULL) && (strcmp(args, "clear") == 0)) {
+                                        fcastClear();
+                                    }
+                                    showForecast();
+                                    whichCommand = i;
+                                    break;
+                                case 24:                                                        // ZED speed: baud [scan].
+                                    if ((args != NULL) && (strcmp(args, "scan") == 0)) {
+                                        baudScan(false);
+                                    }
+                                    showBaud();
+                                    whichCommand = i;
+                                    break;
                             }
                             // -- Test/config the HC-12 radio. --
                             if (testRad) {
@@ -673,7 +2278,7 @@ void checkSerialUSB() {
             }
             posn = 0;                                                                           // Reset for next command.
             memset(command, '\0', sizeof(command));
-        } else {
+        } else if (posn < sizeof(command) - 1) {
             command[posn] = serialChar;                                                         // Add input to buffer.
             posn++;
         }
@@ -682,125 +2287,4789 @@ void checkSerialUSB() {
 
 /**
  * ------------------------------------------------
- *      Check serial 1 (EVK-RTCM). Send to serial 2 (HC-12 radio).
+ *      Task monitor snapshot.
  * ------------------------------------------------
- * 
- * RTCM preamble = '11010011 000000xx' = 0xd3 0x00.
  *
- * @return void No output is returned.
- * @since  0.1.0  [2025-05-29-10:30pm] New.
- * @since  3.0.9  [2025-12-14-06:00pm] Version 3.
- * @since  3.0.10 [2025-12-14-06:00pm] Match Ghost_Rover.ino.
- * @see    Global vars: Serial.
- * @see    startSerialInterfaces().
- * @see    loop().
- * @link   https://github.com/sparkfun/SparkFun_u-blox_GNSS_v3/blob/main/examples/ZED-F9P/Example3_StartRTCMBase/Example3_StartRTCMBase.ino.
- * @link   https://www.use-snip.com/kb/knowledge-base/an-rtcm-message-cheat-sheet/.
- * @link   https://www.use-snip.com/kb/knowledge-base/rtcm-3-message-list/.
- * @link   https://www.singularxyz.com/blog_detail/11.
+ * @param  uint32_t * cpu         Per taskMon entry window CPU (0.1%), TASK_MON_MAX_TASKS.
+ * @param  uint32_t * loopRate    loop() passes/s over the window.
+ * @param  uint32_t * loopRateMin Lowest loop() rate since boot.
+ * @return uint8_t Samples in the window (< 2 = no rates yet).
+ * @since  3.1.0 [2026-10-17-11:59pm] New. From showTasks().
+ * @see    showTasks().
+ * @see    binRequest().
  */
-void checkRTCMtoRadio() {
+uint8_t taskMonSnapshot(uint32_t * cpu, uint32_t * loopRate, uint32_t * loopRateMin) {
 
     // -- Local vars. --
-    static uint8_t  preamble  = 0;
-    static uint16_t byteCount = 0;
-           uint16_t msg_type  = 0;
+    uint32_t total;
+    uint8_t  head;
+    uint8_t  tail;
+    uint8_t  samples;
 
-    // -- Read Serial0 (EVK RTCM3) input. Send to Serial1 (HC-12 radio). --
-    if (Serial0.available() > 0) {                                  // EVK RTCM3 data to read?
-        serialChar = Serial0.read();                                // Read a character from Serial0 (EVK RTCM3) @ SERIAL0_SPEED.
-        Serial1.write(serialChar);                                  // Write a character to Serial1 (HC-12 radio) @ SERIAL1_SPEED.
-        if (serialChar == 0xd3) {                                   // Look for preamble (beginning of RTCM3 sentence).
-            preamble = (preamble == 0) ? 1 : 2;                     // First (1) or new (2) preamble?
-        }
-        if (preamble == 1) {                                        // First preamble.
-            rtcmSentence[byteCount] = serialChar;                   // Add byte to sentence buffer.
-            byteCount++;                                            // Increment byte counter.
-        } else if (preamble == 2) {                                 // New Preamble.
-            if (debugRad) {                                         // Debug.
-                msg_type = rtcm3GetMessageType(rtcmSentence);       // Parse message type.
-                Serial.printf("\nRTCM3 %ld: %i bytes.\n",  msg_type, byteCount);
-                for (size_t i = 0; i < byteCount; i++) {
-                    Serial.printf("%02x ", rtcmSentence[i]);
-                }
-                Serial.println();
-            }
-            updateLED('2');                                         // Blink LED.
-            byteCount = 0;
-            preamble = 0;
-            memset(rtcmSentence, '\0', sizeof(rtcmSentence));       // Clear the RTCM3 sentence buffer.
-        }
+    taskENTER_CRITICAL(&taskMonMux);
+    samples = taskMonSamples;
+    head    = taskMonHead;
+    tail    = (samples > 0) ? (head + TASK_MON_WINDOW + 2 - samples) % (TASK_MON_WINDOW + 1) : head;
+    total   = taskMonTotal[head] - taskMonTotal[tail];
+    for (size_t j = 0; j < TASK_MON_MAX_TASKS; j++) {
+        cpu[j] = (total == 0) ? 0 :
+                 (uint32_t) (((uint64_t) (taskMon[j].runTime[head] - taskMon[j].runTime[tail]) * 1000) / total);
     }
+    *loopRate    = (samples > 1) ? (taskMonLoops[head] - taskMonLoops[tail]) * 1000 /
+                                   ((samples - 1) * TASK_MON_PERIOD * portTICK_PERIOD_MS) : 0;
+    *loopRateMin = taskMonLoopRateMin;
+    taskEXIT_CRITICAL(&taskMonMux);
+    return samples;
 }
 
 /**
- * Return RTCM3 message type.
+ * ------------------------------------------------
+ *      USB binary protocol: input byte.
+ * ------------------------------------------------
  *
- * RTCM3 message structure:
- *   Byte 0: Preamble (0xD3).
- *   Byte 1-2: Reserved (6 bits) + Message length (10 bits).
- *   Byte 3-4: Message type (12 bits) + rest of message.
- *      - Message type starts at bit 24 (byte 3) and is 12 bits long.
- *      - It occupies the upper 8 bits of byte 3 and upper 4 bits of byte 4.
+ * Requests & responses are COBS encoded & framed by 0x00 on both sides. Text never contains 0x00, so a 0x00 starts
+ * a binary frame & the next 0x00 ends it; text lines & binary frames interleave freely. A response is written in one
+ * go (never split by text) or dropped if the USB TX buffer lacks room - the relay never blocks on the host.
+ * See tools/relay_client.py.
  *
- * @param  array RTCM3 sentence.
- * @return uint16_t Message type.
- * @since  0.8.7 [2025-12-16-06:00pm] New.
- * @see    checkRTCMtoRadio().
- * @link   https://portal.u-blox.com/s/question/0D52p0000C7MwDfCQK/can-you-find-out-the-message-type-of-a-given-rtcm3-message.
+ * @param  uint8_t b Byte read from USB.
+ * @return bool Byte belongs to a binary frame (not text).
+ * @since  3.1.0 [2026-10-17-11:59pm] New.
+ * @see    checkSerialUSB().
  */
-uint16_t rtcm3GetMessageType(const char *buffer) {
-    // Serial.printf("[%02x] [%02x] [%02x] [%02x] [%02x]\n", buffer[0],  buffer[1], buffer[2], buffer[3], buffer[3]);
-    if (buffer[0] != 0xD3) {    // Check if preamble is correct
-        return 0;               // Invalid preamble.
+bool binByte(uint8_t b) {
+
+    // -- Local vars. --
+    uint8_t req[BIN_MAX_PAYLOAD];
+    size_t  len;
+
+    if (!bin.inFrame) {
+        if (b != 0) {
+            return false;                                           // Text.
+        }
+        bin.inFrame  = true;
+        bin.overflow = false;
+        bin.len      = 0;
+        return true;
+    }
+    if (b != 0) {
+        if (bin.len < sizeof(bin.rx)) {
+            bin.rx[bin.len++] = b;
+        } else {
+            bin.overflow = true;
+        }
+        return true;
+    }
+    if (bin.len == 0) {                                             // 0x00 0x00 - resync, still a frame start.
+        return true;
     }
-    uint16_t message_type = ((uint16_t)buffer[3] << 4) | (buffer[4] >> 4);
-    return message_type;
+    bin.inFrame = false;
+    len = bin.overflow ? 0 : cobsDecode(bin.rx, bin.len, req, sizeof(req));
+    if (len < 2) {                                                  // Op & sequence at least.
+        bin.errors++;
+        return true;
+    }
+    binRequest(req, len);
+    return true;
 }
 
 /**
  * ------------------------------------------------
- *      Toggle LEDs.
+ *      USB binary protocol: handle request.
  * ------------------------------------------------
  *
- * @param  char ledR Radio LED.
+ * Request [op][seq][args]. Response [op | 0x80][seq][status][data]. Data is little endian, fixed layout per op
+ * (tools/relay_client.py decodes it):
+ *   BIN_INFO     version, uptime ms, loops, requests, last us, max us, dropped, errors (u32), debug, radio2 (u8),
+ *                build date (text).
+ *   BIN_STATS    flightCounters (9 u32), epoch, period ms, budget (u32), ratio[GNSS_NUM] (u8), link bytes[2], hop
+ *                saved, hop saved/epoch, Serial0 & Serial1 re-inits (u32), stalled, power mode (u8), RX high (u16).
+ *   BIN_LATENCY  count (u8), then per constellation n (u32), lastIn, last, avg, min, max (i32); then arrival
+ *                timestamp error bound, event jitter max, read lag avg & max (us), bytes with no mark (u32).
+ *   BIN_WDOG     buckets (u8), bucket limits, detect & recover counts (u32 each), last detect, last recover (u32).
+ *   BIN_TASKS    samples (u8), loop rate, min (u32), count (u8), then per task name (12), CPU, peak (u16, 0.1%),
+ *                stack free (u32).
+ *   BIN_CFG_GET  pending (u8), count (u8), then per field name (9), value, lo, hi (u32), flags (u8: 1 reboot,
+ *                2 differs from NVS).
+ *   BIN_CFG_SET  args index (u8), value (u32); index 0xfe = commit, 0xff = defaults.
+ *   BIN_CMD      args command text - run as if typed. Only BIN_CMD_ALLOWED commands & no arguments ("cfg x 1",
+ *                "hot clear" ... change state): show only, no loop() stall, short output, so automation can poll
+ *                them at 10 Hz without adding relay latency or changing the relay.
+ *
+ * @param  const uint8_t * req Decoded request.
+ * @param  size_t          len Request bytes.
  * @return void No output is returned.
- * @since  0.3.3 [2025-05-29-10:00pm] New.
- * @since  3.0.9 [2025-12-14-02:00pm] Version 3.
- * @link   https://www.freertos.org/Documentation/02-Kernel/04-API-references/02-Task-control/06-vTaskSuspend.
- * @link   https://www.freertos.org/Documentation/02-Kernel/04-API-references/02-Task-control/07-vTaskResume.
+ * @since  3.1.0 [2026-10-17-11:59pm] New.
+ * @since  3.1.1 [2026-10-18-02:30am] BIN_LATENCY arrival timestamp stats.
+ * @since  3.1.1 [2026-10-18-05:00am] BIN_CMD allow-list by name.
+ * @since  3.1.1 [2026-10-18-06:00am] BIN_CMD show only: no arguments, decim (toggles) off the list.
+ * @see    binByte().
  */
-void updateLED(char ledR) {
+void binRequest(const uint8_t * req, size_t len) {
 
-    // --- Radio LED. ---
-    switch (ledR) {
-        case '0':
-            digitalWrite(LED_RADIO, LOW);               // LED off.
+    // -- Local vars. --
+    int64_t  start = esp_timer_get_time();
+    uint8_t  resp[BIN_MAX_PAYLOAD];
+    uint8_t  out[BIN_MAX_PAYLOAD + 4];
+    size_t   pos   = 3;
+    size_t   outLen;
+    uint8_t  u8;
+    uint16_t u16;
+    uint32_t u32;
+    relayConfig next;                                               // Config with a field changed (validity).
+
+    resp[0] = req[0] | 0x80;
+    resp[1] = req[1];
+    resp[2] = BIN_OK;
+    bin.requests++;
+    switch (req[0]) {
+        case BIN_INFO: {
+            uint32_t info[8] = {BIN_VERSION, (uint32_t) millis(), loopCount, bin.requests, bin.lastUs, bin.maxUs, bin.dropped,
+                                bin.errors};
+            binPut(resp, &pos, info, sizeof(info));
+            u8 = DEBUG_BUILD;
+            binPut(resp, &pos, &u8, 1);
+            u8 = RADIO2_BUILD;
+            binPut(resp, &pos, &u8, 1);
+            binPut(resp, &pos, BUILD_DATE, strlen(BUILD_DATE));
             break;
-        case '1':
-            digitalWrite(LED_RADIO, HIGH);              // LED on.
+        }
+        case BIN_STATS: {
+            uint32_t link[4] = {radioLinkBytes[0], radioLinkBytes[1], hop.saved, hop.avgSaved};
+            binPut(resp, &pos, &flightRec.now, sizeof(flightRec.now));
+            binPut(resp, &pos, &decim.epoch, 4);
+            binPut(resp, &pos, &decim.periodMs, 4);
+            binPut(resp, &pos, &decim.budget, 4);
+            binPut(resp, &pos, decim.ratio, GNSS_NUM);
+            binPut(resp, &pos, link, sizeof(link));
+            binPut(resp, &pos, &wdog.rxReinits, 4);
+            binPut(resp, &pos, &wdog.txReinits, 4);
+            u8 = wdog.stalled;
+            binPut(resp, &pos, &u8, 1);
+            u8 = power.mode;
+            binPut(resp, &pos, &u8, 1);
+            u16 = telemRxHighWater;
+            binPut(resp, &pos, &u16, 2);
             break;
-        case '2':
-            vTaskResume(radioRtcmLEDtaskHandle);        // Resume task.
+        }
+        case BIN_LATENCY:
+            u8 = GNSS_NUM;
+            binPut(resp, &pos, &u8, 1);
+            binPut(resp, &pos, latStats, sizeof(latStats));
+            u32 = (uint32_t) rxTs.byteUs + rxTs.jitterMax;              // Arrival timestamp error bound (us).
+            binPut(resp, &pos, &u32, 4);
+            binPut(resp, &pos, &rxTs.jitterMax, 4);
+            binPut(resp, &pos, &rxTs.lagAvg, 4);
+            binPut(resp, &pos, &rxTs.lagMax, 4);
+            binPut(resp, &pos, &rxTs.fallbacks, 4);
+            break;
+        case BIN_WDOG:
+            u8 = WDOG_BUCKETS;
+            binPut(resp, &pos, &u8, 1);
+            binPut(resp, &pos, WDOG_BUCKET_MS, sizeof(WDOG_BUCKET_MS));
+            binPut(resp, &pos, wdog.detectHist, sizeof(wdog.detectHist));
+            binPut(resp, &pos, wdog.recoverHist, sizeof(wdog.recoverHist));
+            binPut(resp, &pos, &wdog.lastDetect, 4);
+            binPut(resp, &pos, &wdog.lastRecover, 4);
+            break;
+        case BIN_TASKS: {
+            uint32_t cpu[TASK_MON_MAX_TASKS];
+            uint32_t rates[2];
+            size_t   countAt;
+            u8 = taskMonSnapshot(cpu, &rates[0], &rates[1]);
+            binPut(resp, &pos, &u8, 1);
+            binPut(resp, &pos, rates, sizeof(rates));
+            countAt = pos;
+            u8 = 0;
+            binPut(resp, &pos, &u8, 1);
+            for (size_t j = 0; (j < TASK_MON_MAX_TASKS) && (pos + 20 <= sizeof(resp)); j++) {
+                char name[12];
+                if (taskMon[j].name[0] == '\0') {
+                    continue;
+                }
+                strncpy(name, taskMon[j].name, sizeof(name));
+                binPut(resp, &pos, name, sizeof(name));
+                u16 = cpu[j];
+                binPut(resp, &pos, &u16, 2);
+                u16 = taskMon[j].cpuPeak;
+                binPut(resp, &pos, &u16, 2);
+                binPut(resp, &pos, &taskMon[j].stackHighWater, 4);
+                resp[countAt]++;
+            }
+            break;
+        }
+        case BIN_CFG_GET:
+            u8 = configPending;
+            binPut(resp, &pos, &u8, 1);
+            u8 = CONFIG_NUM_FIELDS;
+            binPut(resp, &pos, &u8, 1);
+            for (size_t i = 0; i < CONFIG_NUM_FIELDS; i++) {
+                char name[9];
+                strncpy(name, CONFIG_FIELDS[i].name, sizeof(name));
+                binPut(resp, &pos, name, sizeof(name));
+                binPut(resp, &pos, &(config.*CONFIG_FIELDS[i].field), 4);
+                binPut(resp, &pos, &CONFIG_FIELDS[i].lo, 4);
+                binPut(resp, &pos, &CONFIG_FIELDS[i].hi, 4);
+                u8 = (CONFIG_FIELDS[i].reboot ? 1 : 0) |
+                     ((config.*CONFIG_FIELDS[i].field != configStored.*CONFIG_FIELDS[i].field) ? 2 : 0);
+                binPut(resp, &pos, &u8, 1);
+            }
+            break;
+        case BIN_CFG_SET:
+            if ((len == 3) && (req[2] == 0xfe)) {                   // Commit.
+                configPending = true;
+            } else if ((len == 3) && (req[2] == 0xff)) {            // Defaults.
+                configDefaults(&config);
+                applyConfig();
+            } else if ((len == 7) && (req[2] < CONFIG_NUM_FIELDS)) {
+                memcpy(&u32, &req[3], 4);
+                next = config;
+                next.*CONFIG_FIELDS[req[2]].field = u32;
+                if ((u32 < CONFIG_FIELDS[req[2]].lo) || (u32 > CONFIG_FIELDS[req[2]].hi) || !configValid(&next)) {
+                    resp[2] = BIN_BAD_ARG;
+                    break;
+                }
+                config.*CONFIG_FIELDS[req[2]].field = u32;
+                if (!CONFIG_FIELDS[req[2]].reboot) {
+                    applyConfig();
+                }
+            } else {
+                resp[2] = BIN_BAD_ARG;
+            }
             break;
+        case BIN_CMD: {
+            size_t word;
+            if (bin.inject[bin.injectPos] != '\0') {               // Previous command still being fed.
+                resp[2] = BIN_BUSY;
+                break;
+            }
+            if ((len < 3) || (len - 2 > sizeof(bin.inject) - 2) || (memchr(&req[2], '\n', len - 2) != NULL) ||
+                (memchr(&req[2], '\r', len - 2) != NULL)) {
+                resp[2] = BIN_BAD_ARG;
+                break;
+            }
+            memcpy(bin.inject, &req[2], len - 2);
+            bin.inject[len - 2] = '\0';
+            word = strcspn(bin.inject, " ");
+            resp[2] = BIN_BAD_ARG;
+            if (bin.inject[word + strspn(&bin.inject[word], " ")] != '\0') {   // Arguments (set, clear ...) - refused.
+                word = 0;
+            }
+            for (size_t k = 0; k < sizeof(BIN_CMD_ALLOWED) / sizeof(BIN_CMD_ALLOWED[0]); k++) {
+                if ((strlen(BIN_CMD_ALLOWED[k]) == word) && (strncmp(bin.inject, BIN_CMD_ALLOWED[k], word) == 0)) {
+                    resp[2] = BIN_OK;
+                }
+            }
+            if (resp[2] != BIN_OK) {
+                bin.inject[0] = '\0';
+                bin.injectPos = 0;
+                break;
+            }
+            bin.inject[len - 2] = '\n';
+            bin.inject[len - 1] = '\0';
+            bin.injectPos = 0;
+            break;
+        }
+        default:
+            resp[2] = BIN_BAD_OP;
+            bin.errors++;
     }
-}
 
-// --- Test. ---
+    // -- Send (whole frame or nothing). --
+    out[0] = 0;
+    outLen = cobsEncode(resp, pos, &out[1]) + 1;
+    out[outLen++] = 0;
+    if (Serial.availableForWrite() >= (int) outLen) {
+        Serial.write(out, outLen);
+    } else {
+        bin.dropped++;
+    }
+    bin.lastUs = (uint32_t) (esp_timer_get_time() - start);
+    bin.maxUs  = max(bin.maxUs, bin.lastUs);
+}
 
 /**
- * ============================================================================
- *                          Setup.
- * ============================================================================
+ * ------------------------------------------------
+ *      USB binary protocol: append to response.
+ * ------------------------------------------------
  *
- * @return void  No output is returned.
- * @since  3.0.9 [2025-12-14-02:00pm] New.
+ * @param  uint8_t *    resp Response buffer (BIN_MAX_PAYLOAD).
+ * @param  size_t *     pos  Write position, advanced.
+ * @param  const void * data Bytes.
+ * @param  size_t       len  Byte count (truncated to fit).
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:59pm] New.
+ * @see    binRequest().
  */
-void setup() {
-    showBuild();                        // Show build & processor info.
-    startSerial();                      // Start serial interfaces.
-    initVars();                         // Initialize global vars.
-    initPins();                         // Initialize pins & pin values.
+void binPut(uint8_t * resp, size_t * pos, const void * data, size_t len) {
+    len = min(len, BIN_MAX_PAYLOAD - *pos);
+    memcpy(&resp[*pos], data, len);
+    *pos += len;
+}
+
+/**
+ * ------------------------------------------------
+ *      COBS encode.
+ * ------------------------------------------------
+ *
+ * Consistent overhead byte stuffing: output has no 0x00, at most len + len / 254 + 1 bytes.
+ *
+ * @param  const uint8_t * in  Bytes.
+ * @param  size_t          len Byte count.
+ * @param  uint8_t *       out Encoded bytes (no delimiter).
+ * @return size_t Encoded length.
+ * @since  3.1.0 [2026-10-17-11:59pm] New.
+ * @see    binRequest().
+ * @link   https://en.wikipedia.org/wiki/Consistent_Overhead_Byte_Stuffing.
+ */
+size_t cobsEncode(const uint8_t * in, size_t len, uint8_t * out) {
+
+    // -- Local vars. --
+    size_t  code = 0;                                               // Position of the current code byte.
+    size_t  o    = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[code] = (uint8_t) (o - code);
+            code = o++;
+        } else {
+            out[o++] = in[i];
+            if (o - code == 0xff) {                                 // Full block, no implied zero.
+                out[code] = 0xff;
+                code = o++;
+            }
+        }
+    }
+    out[code] = (uint8_t) (o - code);
+    return o;
+}
+
+/**
+ * ------------------------------------------------
+ *      COBS decode.
+ * ------------------------------------------------
+ *
+ * @param  const uint8_t * in   Encoded bytes (no delimiter).
+ * @param  size_t          len  Byte count.
+ * @param  uint8_t *       out  Decoded bytes.
+ * @param  size_t          size Room in out.
+ * @return size_t Decoded length, 0 if malformed.
+ * @since  3.1.0 [2026-10-17-11:59pm] New.
+ * @see    binByte().
+ */
+size_t cobsDecode(const uint8_t * in, size_t len, uint8_t * out, size_t size) {
+
+    // -- Local vars. --
+    size_t  i = 0;
+    size_t  o = 0;
+    uint8_t code;
+
+    while (i < len) {
+        code = in[i++];
+        if ((code == 0) || (i + code - 1 > len) || (o + code - 1 > size)) {
+            return 0;
+        }
+        for (uint8_t j = 1; j < code; j++) {
+            out[o++] = in[i++];
+        }
+        if ((code != 0xff) && (i < len)) {                          // Implied zero between blocks.
+            if (o >= size) {
+                return 0;
+            }
+            out[o++] = 0;
+        }
+    }
+    return o;
+}
+
+/**
+ * ------------------------------------------------
+ *      Show deferred boot banner.
+ * ------------------------------------------------
+ *
+ * Prints the banner & boot timeline once the first RTCM3 frame has gone out, or after BOOT_BANNER_DELAY if the
+ * ZED is silent, so USB output never delays the first correction.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:00am] New.
+ * @see    loop().
+ */
+void checkBootBanner() {
+    if (bootBannerShown) {
+        return;
+    }
+    if ((bootTime[BOOT_FIRST_OUT] != 0) || (millis() > BOOT_BANNER_DELAY)) {
+        bootBannerShown = true;
+        showBuild();
+        showBoot();
+        Serial.println();
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Display boot timeline.
+ * ------------------------------------------------
+ *
+ * Times are from reset (esp_timer start). "First frame air" is the modelled HC-12 TX queue drain (radioAirUntil)
+ * once the first relayed frame is written: each frame's first RTCM_DECIDE_AT bytes are held for the relay/decimate
+ * decision before they cut through, & frames held during the boot ZED speed check (once it moves off the last good
+ * speed) or decimated don't count, so it can be several frames after "first byte in".
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:00am] New.
+ * @since  3.1.1 [2026-10-18-05:00am] First frame on air from the airtime model at the cut-through point.
+ * @see    bootMark().
+ * @see    checkSerialUSB().
+ */
+void showBoot() {
+    Serial.println("\nBoot timeline (ms from reset):");
+    for (size_t i = 0; i < BOOT_PHASES; i++) {
+        if (bootTime[i] == 0) {
+            Serial.printf("  %-16s -\n", BOOT_PHASE_NAMES[i]);
+        } else {
+            Serial.printf("  %-16s %6lu.%03lu\n", BOOT_PHASE_NAMES[i],
+                          (unsigned long) (bootTime[i] / 1000), (unsigned long) (bootTime[i] % 1000));
+        }
+    }
+    if (bootFirstAir > 0) {
+        Serial.printf("  %-16s %6lu.%03lu (est.)\n", "first frame air",
+                      (unsigned long) (bootFirstAir / 1000), (unsigned long) (bootFirstAir % 1000));
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Display task CPU, stack & wake-up report.
+ * ------------------------------------------------
+ *
+ * CPU % is averaged over the task monitor's sliding window (up to TASK_MON_WINDOW samples); peak is the busiest
+ * single sample. Stack is the high-water mark (bytes never used). Wakes are counted for relay owned tasks only
+ * (per-task context switch counts need a FreeRTOS trace hook the precompiled core does not provide).
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-09:30am] New.
+ * @see    taskMonitorTask().
+ * @see    checkSerialUSB().
+ */
+void showTasks() {
+
+    // --- Local vars. ---
+    static const char  STATES[]   = "XRBSDI";                                       // Running, Ready, Blocked, ...
+           uint32_t    cpu[TASK_MON_MAX_TASKS];                                     // Window CPU (0.1%).
+           uint32_t    loopRate;
+           uint32_t    loopRateMin;
+           uint8_t     samples;
+           size_t      j;
+
+    // --- Snapshot. ---
+    samples = taskMonSnapshot(cpu, &loopRate, &loopRateMin);
+
+    // --- Report. ---
+    if (samples < 2) {
+        Serial.println("\nTask monitor: not enough samples yet.");
+        return;
+    }
+    Serial.printf("\nTasks (window %lu s):\n", (unsigned long) ((samples - 1) * TASK_MON_PERIOD * portTICK_PERIOD_MS / 1000));
+    Serial.println("  Name              Pri St   CPU%  Peak%  Stack  Wakes");
+    for (j = 0; j < TASK_MON_MAX_TASKS; j++) {
+        if (taskMon[j].name[0] == '\0') {
+            continue;
+        }
+        Serial.printf("  %-16s %4u  %c %3lu.%lu %3lu.%lu %6lu  ", taskMon[j].name, (unsigned) taskMon[j].priority,
+                      STATES[min((size_t) taskMon[j].state, sizeof(STATES) - 2)],
+                      (unsigned long) (cpu[j] / 10), (unsigned long) (cpu[j] % 10),
+                      (unsigned long) (taskMon[j].cpuPeak / 10), (unsigned long) (taskMon[j].cpuPeak % 10),
+                      (unsigned long) taskMon[j].stackHighWater);
+        if (taskMon[j].taskNumber == 0) {
+            Serial.println("-");
+        } else if (strcmp(taskMon[j].name, pcTaskGetName(radioRtcmLEDtaskHandle)) == 0) {
+            Serial.printf("%lu\n", (unsigned long) radioRtcmLEDwakes);
+        } else if (strcmp(taskMon[j].name, pcTaskGetName(taskMonitorTaskHandle)) == 0) {
+            Serial.printf("%lu\n", (unsigned long) taskMonitorWakes);
+        } else {
+            Serial.println("-");
+        }
+    }
+    Serial.printf("loop() rate: %lu/s (min %lu/s).\n", (unsigned long) loopRate, (unsigned long) loopRateMin);
+}
+
+/**
+ * ------------------------------------------------
+ *      Display heap report.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-10:15am] New.
+ * @since  3.1.1 [2026-10-18-05:00am] Heap hook count.
+ * @see    heapSample().
+ * @see    checkSerialUSB().
+ */
+void showHeap() {
+
+    // --- Local vars. ---
+    multi_heap_info_t info;
+
+    heap_caps_get_info(&info, MALLOC_CAP_DEFAULT);
+    Serial.printf("\nHeap: %lu free, %lu min free, %lu largest block, %lu blocks allocated.\n",
+                  (unsigned long) info.total_free_bytes, (unsigned long) info.minimum_free_bytes,
+                  (unsigned long) info.largest_free_block, (unsigned long) info.allocated_blocks);
+    Serial.printf("Since loop() started: new %lu (%lu bytes), blocks %+ld (peak %+ld), free %+ld bytes, "
+                  "smallest largest block %lu.\n",
+                  (unsigned long) heapNewCount, (unsigned long) heapNewBytes,
+                  (long) info.allocated_blocks - (long) heapLoopBlocks, (long) heapPeakBlocks - (long) heapLoopBlocks,
+                  (long) info.total_free_bytes - (long) heapLoopFree, (unsigned long) heapMinLargest);
+    if (HEAP_HOOKS) {
+        Serial.printf("All allocations (heap hooks): %lu (%lu bytes), frees %lu.\n", (unsigned long) heapAllocCount,
+                      (unsigned long) heapAllocBytes, (unsigned long) heapFreeCount);
+    } else {
+        Serial.println("All allocations: not counted (core built without CONFIG_HEAP_USE_HOOKS) - new & blocks only.");
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Display key counters.
+ * ------------------------------------------------
+ *
+ * @param  const char *           label    Line label.
+ * @param  const flightCounters * counters Counters.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-01:30pm] New. From showRecorder().
+ * @see    showRecorder().
+ */
+void showCounters(const char * label, const flightCounters * counters) {
+    Serial.printf("  %s: in %lu bytes, %lu frames, %lu CRC errors, %lu resyncs, %lu overflows, %lu relayed, "
+                  "%lu decimated, %lu telemetry, last frame @ %lu ms.\n", label,
+                  (unsigned long) counters->bytesIn, (unsigned long) counters->framesIn,
+                  (unsigned long) counters->crcErrors, (unsigned long) counters->resyncs,
+                  (unsigned long) counters->rxOverflows, (unsigned long) counters->framesOut,
+                  (unsigned long) counters->decimated, (unsigned long) counters->telemetryOut,
+                  (unsigned long) counters->uptime);
+}
+
+/**
+ * ------------------------------------------------
+ *      Display flight recorder.
+ * ------------------------------------------------
+ *
+ * Counters for this & the previous boot, then the ring oldest first. Times are ms since that record's boot.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-12:00pm] New.
+ * @since  3.1.0 [2026-10-17-11:00pm] Watchdog re-init records.
+ * @see    recorderRecover().
+ * @see    checkSerialUSB().
+ */
+void showRecorder() {
+
+    // --- Local vars. ---
+    static const char * DECISIONS[8] = {"?", "relayed", "decim", "reinit", "held", "?", "?", "BOOT"};
+           uint32_t     head = flightRec.head;
+           uint32_t     first = (head > FR_RECORDS) ? head - FR_RECORDS : 0;
+           uint32_t     meta;
+
+    Serial.printf("\nFlight recorder: boot %lu, %s, %lu records.\n", (unsigned long) flightRec.bootCount,
+                  (flightRecRecovered ? "recovered" : "new"), (unsigned long) (head - first));
+    showCounters("This boot", &flightRec.now);
+    showCounters("Prev boot", &flightRec.prev);
+    Serial.println("      #  Arrival(ms)  Type  Len  CRC  Decision  Air(ms)");
+    for (uint32_t n = first; n < head; n++) {
+        const flightRecord * r = &flightRec.rec[n % FR_RECORDS];
+        meta = r->meta;
+        if (((meta >> 6) & 7) == FR_BOOT) {
+            Serial.printf("  %5lu  %11lu  ---- boot %lu, reset reason %lu ----\n", (unsigned long) n,
+                          (unsigned long) r->arrival, (unsigned long) r->txDone, (unsigned long) (meta >> 20));
+        } else if (((meta >> 6) & 7) == FR_REINIT) {
+            Serial.printf("  %5lu  %11lu  ---- watchdog: Serial%lu re-init ----\n", (unsigned long) n,
+                          (unsigned long) r->arrival, (unsigned long) (meta >> 20));
+        } else if (((meta >> 10) & 0x3ff) > RTCM_MAX_PAYLOAD || r->txDone < r->arrival) {
+            Serial.printf("  %5lu  (corrupt)\n", (unsigned long) n);
+        } else {
+            Serial.printf("  %5lu  %11lu  %4lu %4lu  %s  %-8s  %7lu\n", (unsigned long) n, (unsigned long) r->arrival,
+                          (unsigned long) (meta >> 20), (unsigned long) ((meta >> 10) & 0x3ff),
+                          ((meta & (1 << 9)) ? " ok" : "BAD"), DECISIONS[(meta >> 6) & 7],
+                          (unsigned long) (r->txDone - r->arrival));
+        }
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Record frame in flight recorder.
+ * ------------------------------------------------
+ *
+ * 3 record stores, head & uptime. No checksum update - the header checksum only covers invariant words.
+ *
+ * @param  uint32_t arrival  First byte in (ms since boot).
+ * @param  uint16_t type     Message type.
+ * @param  uint16_t length   Payload length.
+ * @param  bool     crcOk    CRC-24Q passed.
+ * @param  uint8_t  decision FR_RELAYED, ...
+ * @param  uint32_t txDone   Modelled on air complete (ms since boot).
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-12:00pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    rtcmFrameDone().
+ */
+void HOT_FN recorderFrame(uint32_t arrival, uint16_t type, uint16_t length, bool crcOk, uint8_t decision, uint32_t txDone) {
+    flightRecord * r = &flightRec.rec[flightRec.head % FR_RECORDS];
+    r->arrival = arrival;
+    r->meta    = ((uint32_t) type << 20) | ((uint32_t) length << 10) | ((uint32_t) crcOk << 9) | ((uint32_t) decision << 6);
+    r->txDone  = txDone;
+    flightRec.head++;
+    flightRec.now.uptime = arrival;
+}
+
+/**
+ * ------------------------------------------------
+ *      Debug dump of relayed frame.
+ * ------------------------------------------------
+ *
+ * Out of line so checkFrameDone() only carries the debugRad test (none when GR_DEBUG = 0; the linker then drops this).
+ *
+ * @param  uint16_t msgType  Message type.
+ * @param  uint16_t frameLen Frame length (preamble to CRC).
+ * @param  bool     crcOk    CRC-24Q passed.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-05:00pm] New. From rtcmFrameDone().
+ * @see    checkFrameDone().
+ */
+void debugFrame(uint16_t msgType, uint16_t frameLen, bool crcOk) {
+    Serial.printf("\nRTCM3 %u: %u bytes%s.\n", (unsigned) msgType, (unsigned) frameLen, (crcOk ? "" : ", CRC error"));
+    for (size_t i = 0; i < frameLen; i++) {
+        Serial.printf("%02x ", (uint8_t) rtcmSentence[i]);
+    }
+    Serial.println();
+}
+
+/**
+ * ------------------------------------------------
+ *      Debug command available in this build?
+ * ------------------------------------------------
+ *
+ * @param  const char * name Command name.
+ * @return bool True if built with GR_DEBUG (else says so).
+ * @since  3.1.0 [2026-10-17-05:00pm] New.
+ * @see    checkSerialUSB().
+ */
+bool debugAvailable(const char * name) {
+    if (!DEBUG_BUILD) {
+        Serial.printf("%s not in this build (GR_DEBUG = 0).\n", name);
+    }
+    return DEBUG_BUILD;
+}
+
+/**
+ * ------------------------------------------------
+ *      RTCM3 frame complete.
+ * ------------------------------------------------
+ *
+ * @param  uint16_t frameLen Frame length (preamble to CRC).
+ * @param  bool     crcOk    CRC-24Q passed.
+ * @param  uint32_t arrival  First byte in (ms since boot).
+ * @param  uint8_t  decision FR_RELAYED, FR_DECIMATED or FR_HELD.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-12:00pm] New. From checkRTCMtoRadio().
+ * @since  3.1.0 [2026-10-17-03:00pm] Decimation.
+ * @since  3.1.0 [2026-10-17-04:15pm] Epoch to air latency.
+ * @since  3.1.0 [2026-10-17-05:00pm] Debug dump moved to debugFrame().
+ * @since  3.1.0 [2026-10-17-09:00pm] Fields via bitReader.
+ * @since  3.1.0 [2026-10-17-11:30pm] Compact hop saving & air bytes.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @since  3.1.1 [2026-10-18-03:00am] Not recorded during the self test.
+ * @since  3.1.1 [2026-10-18-03:30am] Base profile.
+ * @since  3.1.1 [2026-10-18-04:00am] Epoch forecast masks.
+ * @since  3.1.1 [2026-10-18-04:30am] Speed detection score.
+ * @since  3.1.1 [2026-10-18-05:00am] Decision code (held frames recorded as such).
+ * @since  3.1.1 [2026-10-18-05:00am] Counters, recorder & latency only. The rest (flash code) in checkFrameDone().
+ * @since  3.1.1 [2026-10-18-06:30am] Station read only from 1005/1006/MSM (0 for other types).
+ * @see    checkRTCMtoRadio().
+ * @see    checkFrameDone().
+ */
+void HOT_FN rtcmFrameDone(uint16_t frameLen, bool crcOk, uint32_t arrival, uint8_t decision) {
+
+    // -- Local vars. --
+    bool      relayed  = (decision == FR_RELAYED);
+    uint16_t  msg_type = rtcm3GetMessageType(rtcmSentence);
+    int8_t    gnss     = rtcmMsmGnss(msg_type);
+    uint16_t  station  = 0;
+    bool      more     = false;                                     // MSM multiple message bit.
+    uint16_t  airLen   = (config.hop == HOP_COMPACT) ? hopLen(frameLen) : frameLen;    // Decimation budgets on air bytes.
+    bool      hasId    = (msg_type == 1005) || (msg_type == 1006) || (gnss >= 0);
+    bitReader r;
+
+    if (hasId && (frameLen >= RTCM_DECIDE_AT)) {                    // Station ID (1005/1006/MSM), else 0.
+        bitsInit(&r, (const uint8_t *) rtcmSentence, frameLen, 36);
+        station = bitsGet(&r, 12);
+        if (gnss >= 0) {                                            // MSM multiple message bit.
+            bitsSkip(&r, 30);                                       // MSM epoch time.
+            more = bitsGet(&r, 1);
+        }
+    }
+
+    flightRec.now.framesIn++;
+    if (relayed) {
+        flightRec.now.framesOut++;
+    } else if (decision == FR_DECIMATED) {                          // Held during a speed scan is not decimation.
+        flightRec.now.decimated++;
+    }
+    if (!crcOk) {
+        flightRec.now.crcErrors++;
+    } else if (hasId) {
+        rtcmStationId = station;
+    }
+    if (relayed) {                                                  // Compact hop saving (potential if off).
+        hop.rtcmBytes  += frameLen;
+        hop.saved      += frameLen - hopLen(frameLen);
+        hop.epochSaved += frameLen - hopLen(frameLen);
+    }
+    if (gnss >= 0) {                                                // Decimation accounting.
+        decim.epochBytes[gnss] += airLen;
+    } else {
+        decim.otherBytes += airLen;
+    }
+    if (selfTest.mode == ST_OFF) {                                  // Self test stays out of recorder.
+        recorderFrame(arrival, msg_type, frameLen - 6, crcOk, decision,
+                      (relayed ? (uint32_t) (radioAirUntil / 1000) : arrival));
+    }
+    if (relayed && (gnss >= 0) && crcOk && (rtcmFrameEpoch >= 0)) { // Epoch to air latency.
+        latencyFrame(gnss, rtcmFrameEpoch);
+    }
+    frameDone.msgType   = msg_type;                                 // Rest from loop() (checkFrameDone()).
+    frameDone.gnss      = gnss;
+    frameDone.frameLen  = frameLen;
+    frameDone.airLen    = airLen;
+    frameDone.station   = station;
+    frameDone.crcOk     = crcOk;
+    frameDone.relayed   = relayed;
+    frameDone.epochDone = (gnss >= 0) && crcOk && (frameLen >= RTCM_DECIDE_AT) && !more;   // Last MSM of epoch.
+    frameDone.pending   = true;
+}
+
+/**
+ * ------------------------------------------------
+ *      RTCM3 frame complete - flash side.
+ * ------------------------------------------------
+ *
+ * The per-frame work that is not HOT_FN: speed score, forecast masks, end of epoch planning (fcastEpochDone(),
+ * decimEpochDone()), base profile (may print), debug dump, LED & boot timeline. Runs on the loop() pass after
+ * rtcmFrameDone() - checkRTCMtoRadio() takes one byte per pass, so rtcmSentence still holds the frame. Also closes
+ * an epoch whose last MSM was lost once DECIM_EPOCH_GAP has passed, so rtcmDecide() rarely has to.
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-05:00am] New. From rtcmFrameDone().
+ * @see    rtcmFrameDone().
+ * @see    loop().
+ */
+void checkFrameDone() {
+
+    // -- Local vars. --
+    const bool     timed  = (selfTest.mode != ST_OFF);              // Self test: counted with rtcmFrameDone().
+          uint32_t cycles = timed ? esp_cpu_get_cycle_count() : 0;
+
+    if (!frameDone.pending) {
+        if (decim.epochOpen && !rtcmInFrame && ((esp_timer_get_time() - decim.lastMsm) / 1000 > DECIM_EPOCH_GAP)) {
+            fcastEpochDone();                                       // Last MSM lost - close the epoch now.
+            decimEpochDone();
+        }
+        return;
+    }
+    frameDone.pending = false;
+    if (selfTest.mode == ST_OFF) {
+        baudFrame(frameDone.crcOk);
+    }
+    if ((frameDone.gnss >= 0) && !fcast.open) {                     // First MSM of the epoch.
+        fcastStart(frameDone.gnss, frameDone.frameLen);
+    }
+    if ((frameDone.gnss >= 0) && frameDone.crcOk) {
+        fcastFrame(frameDone.gnss, frameDone.msgType, frameDone.frameLen);
+    }
+    if (frameDone.epochDone) {                                      // Multiple message bit clear - last MSM of epoch.
+        fcastEpochDone();
+        decimEpochDone();
+    }
+    if ((selfTest.mode == ST_OFF) && frameDone.crcOk) {             // Self test stays out of profile.
+        profileFrame(frameDone.msgType, frameDone.gnss, frameDone.airLen, frameDone.station);
+    }
+    if (timed) {
+        selfTestTime(ST_DONE, &cycles);
+    }
+    if (!frameDone.relayed) {
+        return;
+    }
+    if (debugRad) {                                                 // Debug (compiles out if GR_DEBUG = 0).
+        debugFrame(frameDone.msgType, frameDone.frameLen, frameDone.crcOk);
+    }
+    updateLED('2');                                                 // Blink LED.
+    if (bootTime[BOOT_FIRST_OUT] == 0) {                            // Boot timeline.
+        bootFirstAir = radioAirUntil;                               // Cut-through: HC-12 model after this frame.
+        bootMark(BOOT_FIRST_OUT);
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Check serial 1 (EVK-RTCM). Send to serial 2 (HC-12 radio).
+ * ------------------------------------------------
+ * 
+ * RTCM preamble = '11010011 000000xx' = 0xd3 0x00.
+ *
+ * Frames are delimited by the length field (a 0xd3 inside a payload no longer splits a frame), checked with CRC-24Q
+ * on the fly & passed to rtcmFrameDone(). Non-zero reserved bits mean a false preamble - hunt again. Bytes outside
+ * frames are not relayed.
+ *
+ * Cut-through: the first RTCM_DECIDE_AT bytes (enough for the MSM header) are held, rtcmDecide() picks relay or
+ * decimate, then held & following bytes go straight to the HC-12 as they arrive (~1.7 ms hold @ 57600 bps).
+ * With the compact hop the header & CRC-24Q are replaced (see hopHeader()); payload bytes still cut through.
+ *
+ * @return void No output is returned.
+ * @since  0.1.0  [2025-05-29-10:30pm] New.
+ * @since  3.0.9  [2025-12-14-06:00pm] Version 3.
+ * @since  3.0.10 [2025-12-14-06:00pm] Match Ghost_Rover.ino.
+ * @since  3.1.0  [2026-10-17-12:00pm] Length framing, CRC-24Q, flight recorder.
+ * @since  3.1.0  [2026-10-17-03:00pm] Cut-through with relay/decimate decision.
+ * @since  3.1.0  [2026-10-17-11:00pm] Resync on watchdog request.
+ * @since  3.1.0  [2026-10-17-11:30pm] Compact hop encoding.
+ * @since  3.1.1  [2026-10-18-12:30am] Framing moved to rtcmParse().
+ * @since  3.1.1  [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @since  3.1.1  [2026-10-18-02:30am] Byte arrival time from UART RX events.
+ * @since  3.1.1  [2026-10-18-03:00am] Self test input & stage timing.
+ * @since  3.1.1  [2026-10-18-04:30am] Held while the ZED speed is scanned.
+ * @since  3.1.1  [2026-10-18-05:00am] Relayed at the last good speed during a scan; held only at other candidates.
+ * @see    Global vars: Serial.
+ * @see    startSerialInterfaces().
+ * @see    loop().
+ * @link   https://github.com/sparkfun/SparkFun_u-blox_GNSS_v3/blob/main/examples/ZED-F9P/Example3_StartRTCMBase/Example3_StartRTCMBase.ino.
+ * @link   https://www.use-snip.com/kb/knowledge-base/an-rtcm-message-cheat-sheet/.
+ * @link   https://www.use-snip.com/kb/knowledge-base/rtcm-3-message-list/.
+ * @link   https://www.singularxyz.com/blog_detail/11.
+ */
+void HOT_FN checkRTCMtoRadio() {
+
+    // -- Local vars. --
+    static uint32_t arrival   = 0;                                  // First byte in (ms).
+    static bool     decided   = false;                              // Relay/decimate decision made.
+    static bool     relay     = false;                              // Relay this frame.
+    static uint8_t  decision  = FR_DECIMATED;                       // FR_RELAYED, FR_DECIMATED or FR_HELD.
+    static bool     compact   = false;                              // Compact hop encoding for this frame.
+           uint16_t byteCount;                                      // Bytes of the frame in rtcmSentence.
+           uint16_t frameLen;                                       // Expected frame length (once header is in).
+           rtcmEvent ev;
+           int64_t  now;
+           int      avail;
+    const  bool     timed     = (selfTest.mode != ST_OFF);          // Self test: per stage cycles.
+           uint32_t cycles    = timed ? esp_cpu_get_cycle_count() : 0;
+
+    if (rtcmResync) {                                               // Watchdog: drop partial frame.
+        rtcmResync   = false;
+        rtcmRx.count = 0;
+        rtcmInFrame  = false;
+    }
+
+    // -- Read Serial0 (EVK RTCM3) input. Send to Serial1 (HC-12 radio). --
+    avail = (selfTest.mode == ST_INTERNAL) ? selfTestAvailable() : Serial0.available();
+    if (avail > 0) {                                                // EVK RTCM3 data to read?
+        if (selfTest.mode == ST_INTERNAL) {                         // Self test generator in place of the UART.
+            serialChar = selfTest.stream[selfTest.genPos];
+            selfTest.genPos = (selfTest.genPos + 1) % selfTest.len;
+            selfTest.taken++;
+            now = esp_timer_get_time();
+        } else {
+            serialChar = Serial0.read();                            // Read a character from Serial0 (EVK RTCM3).
+            now = rxByteTime(rxTs.readIdx++, esp_timer_get_time()); // When it arrived, not when loop() got to it.
+        }
+        telemRxHighWater = max(telemRxHighWater, (uint16_t) avail);
+        rtcmLastByte = now;
+        flightRec.now.bytesIn++;
+        if (bootTime[BOOT_FIRST_IN] == 0) {                         // Boot timeline.
+            bootMark(BOOT_FIRST_IN);
+        }
+        if (timed) {
+            selfTestTime(ST_INPUT, &cycles);
+        }
+        ev = rtcmParse(&rtcmRx, (uint8_t) serialChar);             // Add byte to sentence buffer.
+        if (timed) {
+            selfTestTime(ST_FRAME, &cycles);
+        }
+        if (ev == RTCM_HUNT) {                                      // Hunt for preamble (beginning of RTCM3 sentence).
+            return;
+        }
+        if (ev == RTCM_FALSE) {                                     // Reserved bits set - false preamble.
+            flightRec.now.resyncs++;
+            rtcmInFrame = false;
+            return;
+        }
+        frameLen  = rtcmRx.frameLen;
+        byteCount = (ev == RTCM_BYTE) ? rtcmRx.count : frameLen;
+        if (byteCount == 1) {                                       // Preamble.
+            arrival     = (uint32_t) (now / 1000);
+            decided     = false;
+            rtcmInFrame = true;
+        }
+        if (decided) {                                              // Cut-through.
+            if (relay && !compact) {
+                radioWrite((const uint8_t *) &rtcmSentence[byteCount - 1], 1, rtcmRoute);   // Write to HC-12 radio(s).
+            } else if (relay && (byteCount <= frameLen - 3)) {      // Compact: payload only.
+                hopPayload((const uint8_t *) &rtcmSentence[byteCount - 1], 1);
+            }
+        } else if ((byteCount == RTCM_DECIDE_AT) || ((byteCount > 3) && (byteCount == frameLen))) {
+            decided  = true;
+            if ((baud.stage == BAUD_LOCKED) || (baud.provisional && (baud.idx == 0))) {
+                decision = rtcmDecide(byteCount, now) ? FR_RELAYED : FR_DECIMATED;
+            } else {
+                decision = FR_HELD;                                 // Not while trying other speeds.
+            }
+            relay    = (decision == FR_RELAYED);
+            compact = (config.hop == HOP_COMPACT);
+            if (relay && !compact) {
+                radioWrite((const uint8_t *) rtcmSentence, byteCount, rtcmRoute);   // Held bytes.
+            } else if (relay) {
+                hopHeader(frameLen - 6, rtcmRoute);
+                hopPayload((const uint8_t *) &rtcmSentence[3], min(byteCount, (uint16_t) (frameLen - 3)) - 3);
+            }
+        }
+        if (ev != RTCM_BYTE) {                                      // Frame complete.
+            if (relay && compact) {
+                hopTrailer(ev == RTCM_FRAME_OK);
+            }
+            if (timed) {
+                selfTestTime(ST_OUTPUT, &cycles);
+            }
+            rtcmFrameDone(frameLen, (ev == RTCM_FRAME_OK), arrival, decision);
+            rtcmInFrame = false;
+            if (timed) {
+                selfTestTime(ST_DONE, &cycles);
+            }
+        } else if (timed) {
+            selfTestTime(ST_OUTPUT, &cycles);
+        }
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      RTCM3 framing: one byte.
+ * ------------------------------------------------
+ *
+ * Hunts for the preamble, checks the reserved bits, takes the length from the header & runs CRC-24Q over preamble
+ * to end of payload. On RTCM_FRAME_OK / RTCM_FRAME_BAD the frame is p->buf[0 .. p->frameLen - 1] & the parser is
+ * hunting again. No I/O - the relay, bench & self tests share it.
+ *
+ * @param  rtcmParser * p Parser.
+ * @param  uint8_t      b Byte in.
+ * @return rtcmEvent What the byte did.
+ * @since  3.1.1 [2026-10-18-12:30am] New. From checkRTCMtoRadio().
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    checkRTCMtoRadio().
+ * @see    benchKernel().
+ */
+rtcmEvent HOT_FN rtcmParse(rtcmParser * p, uint8_t b) {
+    if (p->count == 0) {                                            // Hunt for preamble.
+        if (b != RTCM_PREAMBLE) {
+            return RTCM_HUNT;
+        }
+        p->crc      = 0;
+        p->frameLen = 0;
+    }
+    p->buf[p->count++] = b;
+    if ((p->count <= 3) || (p->count <= p->frameLen - 3)) {         // CRC covers preamble to end of payload.
+        p->crc = ((p->crc << 8) ^ crc24qTable[((p->crc >> 16) ^ b) & 0xff]) & 0xffffff;
+    }
+    if (p->count == 3) {                                            // Header in.
+        if ((p->buf[1] & 0xfc) != 0) {                              // Reserved bits set - false preamble.
+            p->count = 0;
+            return RTCM_FALSE;
+        }
+        p->frameLen = (((uint16_t) (p->buf[1] & 0x03) << 8) | p->buf[2]) + 6;
+    }
+    if ((p->count > 3) && (p->count == p->frameLen)) {              // Frame complete.
+        p->count = 0;
+        return (p->crc == (((uint32_t) p->buf[p->frameLen - 3] << 16) | ((uint32_t) p->buf[p->frameLen - 2] << 8) |
+                            (uint32_t) p->buf[p->frameLen - 1])) ? RTCM_FRAME_OK : RTCM_FRAME_BAD;
+    }
+    return RTCM_BYTE;
+}
+
+/**
+ * ------------------------------------------------
+ *      Serial0 byte arrival time.
+ * ------------------------------------------------
+ *
+ * The byte's mark (onSerial0Rx()) gives when its batch was in; the byte itself is (end - 1 - idx) byte times
+ * earlier, & a batch ended by RX timeout (fewer than RX_FIFO_FULL bytes) sat RX_TIMEOUT_SYM symbols before the
+ * event. Error bound: one byte time (FIFO position) + event latency jitter. No mark (events lost) = read time.
+ *
+ * @param  uint32_t idx    Serial0 byte index (rxTs.readIdx when read).
+ * @param  int64_t  readAt Read time (esp_timer us).
+ * @return int64_t Arrival (esp_timer us).
+ * @since  3.1.1 [2026-10-18-02:30am] New.
+ * @see    checkRTCMtoRadio().
+ */
+int64_t HOT_FN rxByteTime(uint32_t idx, int64_t readAt) {
+
+    // -- Local vars. --
+    uint8_t  i;
+    int64_t  at = readAt;
+    uint32_t lag;
+
+    taskENTER_CRITICAL(&rxTsMux);
+    i = rxTs.cursor;
+    while ((i != rxTs.head) && (rxTs.marks[i].end <= idx)) {
+        i = (i + 1) % RX_MARKS;
+    }
+    rxTs.cursor = i;
+    if ((i != rxTs.head) && (idx + rxTs.marks[i].count >= rxTs.marks[i].end)) {
+        at = rxTs.marks[i].at - (int64_t) (rxTs.marks[i].end - 1 - idx) * rxTs.byteUs -
+             ((rxTs.marks[i].count < RX_FIFO_FULL) ? RX_TIMEOUT_SYM * rxTs.byteUs : 0);
+    }
+    taskEXIT_CRITICAL(&rxTsMux);
+    if (at == readAt) {
+        rxTs.fallbacks++;
+        return readAt;
+    }
+    at  = min(at, readAt);
+    lag = (uint32_t) (readAt - at);
+    rxTs.lagMax  = max(rxTs.lagMax, lag);
+    rxTs.lagAvg += ((int32_t) lag - (int32_t) rxTs.lagAvg) / 64;
+    return at;
+}
+
+/**
+ * ------------------------------------------------
+ *      Receiver role: HC-12 in, RTCM3 out to the GNSS.
+ * ------------------------------------------------
+ *
+ * The rover end of the link (cfg role 1). Radio bytes from Serial1 are framed - standard RTCM3 by rtcmParse(), or
+ * compact hop frames by rxHopByte() & rebuilt as RTCM3 - & only CRC-valid frames go out on Serial0 TX (RTCM_OUT),
+ * whole, so the GNSS never sees a frame broken on air. Serial0 RX is not used.
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-01:30am] New.
+ * @see    rxFrame().
+ */
+void HOT_FN checkRadioToGnss() {
+
+    // -- Local vars. --
+    int       c;
+    uint32_t  nowMs;
+    rtcmEvent ev;
+
+    while ((c = Serial1.read()) >= 0) {
+        nowMs        = millis();
+        rtcmLastByte = esp_timer_get_time();                        // inEpochGap() - cfg commit & update in the gaps.
+        rx.bytesIn++;
+        if (config.hop == HOP_COMPACT) {
+            rxHopByte((uint8_t) c, nowMs);
+        } else {
+            ev = rtcmParse(&rtcmRx, (uint8_t) c);
+            if (ev == RTCM_FRAME_OK) {
+                rxFrame(rtcmRx.frameLen, nowMs);
+            } else if (ev == RTCM_FRAME_BAD) {
+                rx.crcErrors++;
+            }
+        }
+        rx.lastByte = nowMs;
+        rtcmInFrame = (rtcmRx.count > 0) || (rx.hopCount > 0);
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Receiver role: compact hop frame, one byte.
+ * ------------------------------------------------
+ *
+ * [length 1-2][payload][CRC-16] (see hopHeader()). The payload lands in rtcmSentence after a 3 byte gap, so a good
+ * frame becomes RTCM3 in place: preamble & length in front, CRC-24Q behind. There is no preamble to hunt for, so a
+ * quiet RX_SYNC_GAP (the inter-epoch gap) marks a frame boundary; one CRC failure is taken as payload damage, two in
+ * a row as a lost boundary (hunt until the next gap). A poisoned CRC-16 (~CRC) is a frame the relay got broken.
+ *
+ * @param  uint8_t  b     Byte in.
+ * @param  uint32_t nowMs Now (ms).
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-01:30am] New.
+ * @see    checkRadioToGnss().
+ */
+void HOT_FN rxHopByte(uint8_t b, uint32_t nowMs) {
+
+    // -- Local vars. --
+    uint8_t * frame = (uint8_t *) rtcmSentence;
+    uint32_t  crc;
+
+    if (nowMs - rx.lastByte >= RX_SYNC_GAP) {                       // Quiet gap - this byte starts a frame.
+        rx.hopCount  = 0;
+        rx.hopSynced = true;
+    }
+    if (!rx.hopSynced) {                                            // Hunting - wait for a gap.
+        return;
+    }
+    if (rx.hopCount == 0) {                                         // Length, low 7 bits.
+        rx.hopCrc  = 0xffff;
+        rx.hopLen  = b & 0x7f;
+        rx.hopHead = (b & 0x80) ? 2 : 1;
+    } else if ((rx.hopCount == 1) && (rx.hopHead == 2)) {           // Length, high 3 bits.
+        if (b > 7) {                                                // Not a 10 bit length - lost.
+            rx.crcErrors++;
+            rx.hopSynced = false;
+            return;
+        }
+        rx.hopLen |= (uint16_t) b << 7;
+    } else if (rx.hopCount < rx.hopHead + rx.hopLen) {              // Payload, in place for RTCM3.
+        frame[3 + rx.hopCount - rx.hopHead] = b;
+    } else {                                                        // CRC-16, big endian.
+        rx.hopRxCrc = (uint16_t) ((rx.hopRxCrc << 8) | b);
+    }
+    if (rx.hopCount < rx.hopHead + rx.hopLen) {
+        rx.hopCrc = crc16(rx.hopCrc, &b, 1);
+    }
+    if (++rx.hopCount < rx.hopHead + rx.hopLen + 2) {
+        return;
+    }
+    rx.hopCount = 0;
+    if (rx.hopRxCrc == rx.hopCrc) {                                 // Good - rebuild RTCM3.
+        rx.hopBad = 0;
+        frame[0]  = RTCM_PREAMBLE;
+        frame[1]  = (uint8_t) (rx.hopLen >> 8);
+        frame[2]  = (uint8_t) rx.hopLen;
+        crc       = crc24q(frame, rx.hopLen + 3);
+        frame[rx.hopLen + 3] = (uint8_t) (crc >> 16);
+        frame[rx.hopLen + 4] = (uint8_t) (crc >> 8);
+        frame[rx.hopLen + 5] = (uint8_t) crc;
+        rxFrame(rx.hopLen + 6, nowMs);
+    } else if (rx.hopRxCrc == (uint16_t) ~rx.hopCrc) {              // Poisoned at the relay - still in sync.
+        rx.hopBad = 0;
+        rx.poisoned++;
+    } else {
+        rx.crcErrors++;
+        if (++rx.hopBad >= 2) {                                     // Boundary lost - hunt until a gap.
+            rx.hopSynced = false;
+        }
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Receiver role: valid frame out & stats.
+ * ------------------------------------------------
+ *
+ * Gap: time between valid frames (the tail shows outages). Age: since the last valid frame - what the GNSS sees as
+ * correction age. Loss: MSM epoch time steps longer than the epoch period (shortest step seen) count the epochs
+ * missing in between - epochs the relay decimated for a constellation still carry the others, so they are not lost.
+ *
+ * Each frame is tagged by its own CRC-24Q & length, so the air format stays standard RTCM3 / compact hop: a tag seen
+ * again soon is a duplicate (base & repeater both heard) or an echo (repeaters hearing each other) & dropped. An MSM
+ * carries its epoch time, so its tag is unique per epoch & RX_DUP_WINDOW is safe. Static frames (1005, 1006, 1033,
+ * 1230 ...) are byte-identical every time they are sent, so theirs only holds for half an epoch (at most
+ * RX_DUP_STATIC) - the next epoch's copy goes through. An MSM more than RX_MAX_AGE behind the newest epoch arrived
+ * by a slow path & is dropped too.
+ *
+ * @param  uint16_t frameLen RTCM3 frame in rtcmSentence.
+ * @param  uint32_t nowMs    Now (ms).
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-01:30am] New.
+ * @since  3.1.1 [2026-10-18-02:00am] Duplicate, echo & stale frame drop; repeater.
+ * @since  3.1.1 [2026-10-18-06:00am] Static frames: duplicate window under one epoch.
+ * @see    checkRadioToGnss().
+ */
+void HOT_FN rxFrame(uint16_t frameLen, uint32_t nowMs) {
+
+    // -- Local vars. --
+    const uint8_t * frame = (const uint8_t *) rtcmSentence;
+          int8_t    gnss  = rtcmMsmGnss(rtcm3GetMessageType(rtcmSentence));
+          int64_t   epoch = -1;
+          int64_t   step;
+          uint32_t  tag;
+
+    if (rx.framesOk++ > 0) {
+        wdogHistogram(rx.gapHist, nowMs - rx.lastFrame);
+        rx.maxGap = max(rx.maxGap, nowMs - rx.lastFrame);
+    }
+    rx.lastFrame = nowMs;
+    tag = ((uint32_t) frame[frameLen - 3] << 24) | ((uint32_t) frame[frameLen - 2] << 16) |
+          ((uint32_t) frame[frameLen - 1] << 8) | (frameLen & 0xff);
+    if (rxSeenTag(tag, nowMs, (gnss >= 0) ? RX_DUP_WINDOW
+                                          : ((rx.periodMs > 0) ? min(rx.periodMs / 2, RX_DUP_STATIC) : RX_DUP_STATIC))) {
+        rx.dups++;
+        return;
+    }
+    if ((gnss >= 0) && (frameLen >= RTCM_DECIDE_AT)) {
+        epoch = msmEpochGps(gnss);
+    }
+    if ((epoch >= 0) && (rx.lastEpoch >= 0) && (gpsWeekWrap(epoch - rx.lastEpoch) < -(int64_t) RX_MAX_AGE)) {
+        rx.stale++;
+        return;
+    }
+    if (role == ROLE_REPEATER) {
+        repeatFrame(frameLen);
+    } else if (Serial0.availableForWrite() >= frameLen) {
+        Serial0.write((const uint8_t *) rtcmSentence, frameLen);   // Whole frame to the GNSS.
+        rx.framesOut++;
+        rx.bytesOut += frameLen;
+        updateLED('2');                                             // Blink LED.
+    } else {
+        rx.outDrops++;
+    }
+    if ((epoch < 0) || (epoch == rx.lastEpoch)) {
+        return;
+    }
+    if (rx.lastEpoch < 0) {
+        rx.epochs++;
+        rx.lastEpoch = epoch;
+        return;
+    }
+    step = gpsWeekWrap(epoch - rx.lastEpoch);
+    if (step <= 0) {                                                // Older epoch (constellation order) - ignore.
+        return;
+    }
+    rx.epochs++;
+    rx.lastEpoch = epoch;
+    if ((rx.periodMs == 0) || (step < rx.periodMs)) {
+        rx.periodMs = (uint32_t) step;
+    }
+    if (step > rx.periodMs + rx.periodMs / 2) {
+        rx.epochsLost += (uint32_t) ((step + rx.periodMs / 2) / rx.periodMs) - 1;
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Receiver role: recent frame tags.
+ * ------------------------------------------------
+ *
+ * @param  uint32_t tag    Frame tag (CRC-24Q & length).
+ * @param  uint32_t nowMs  Now (ms).
+ * @param  uint32_t window Duplicate window (ms).
+ * @return bool Seen within window (else remembered now).
+ * @since  3.1.1 [2026-10-18-02:00am] New.
+ * @since  3.1.1 [2026-10-18-06:00am] Window per frame (static frames shorter).
+ * @see    rxFrame().
+ */
+bool HOT_FN rxSeenTag(uint32_t tag, uint32_t nowMs, uint32_t window) {
+    for (size_t i = 0; i < RX_SEEN; i++) {
+        if ((rx.seen[i].tag == tag) && (rx.seen[i].at != 0) && (nowMs - rx.seen[i].at < window)) {
+            return true;
+        }
+    }
+    rx.seen[rx.seenHead] = {tag, max(nowMs, (uint32_t) 1)};
+    rx.seenHead = (rx.seenHead + 1) % RX_SEEN;
+    return false;
+}
+
+/**
+ * ------------------------------------------------
+ *      Repeater role: send a frame again.
+ * ------------------------------------------------
+ *
+ * Store & forward: the frame goes out whole (standard or compact, per cfg hop) once it is in & valid, on the 2nd
+ * HC-12's channel (GR_RADIO2), so rovers listen there & the repeater keeps receiving. Never on Serial1's own channel:
+ * frame by frame it would transmit during the base's burst, colliding at rovers in range of both & losing its own
+ * input (half duplex) - configValid() & startSerial() keep the repeater role to builds & configs with the 2nd radio.
+ * Added latency: frame in to its modelled last byte on air - what a rover in range of both would see between copies.
+ *
+ * @param  uint16_t frameLen RTCM3 frame in rtcmSentence.
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-02:00am] New.
+ * @since  3.1.1 [2026-10-18-05:00am] 2nd radio only.
+ * @since  3.1.1 [2026-10-18-06:00am] LINK_2 direct (no dead link choice).
+ * @see    rxFrame().
+ */
+void HOT_FN repeatFrame(uint16_t frameLen) {
+
+    // -- Local vars. --
+    int64_t  now   = esp_timer_get_time();
+    uint16_t len   = (config.hop == HOP_COMPACT) ? hopLen(frameLen) : frameLen;
+    uint32_t added;
+
+    if (max(radioLinkUntil[1], now) - now + (int64_t) len * radioByteUs > (int64_t) RX_MAX_AGE * 1000) {
+        rx.rep.queueDrops++;                                        // Would air too late to be useful.
+        return;
+    }
+    if (config.hop == HOP_COMPACT) {
+        hopHeader(frameLen - 6, LINK_2);
+        hopPayload((const uint8_t *) &rtcmSentence[3], frameLen - 6);
+        hopTrailer(true);
+    } else {
+        radioWrite((const uint8_t *) rtcmSentence, frameLen, LINK_2);
+    }
+    added = (uint32_t) ((radioLinkUntil[1] - now) / 1000);       // Link 2 queue.
+    rx.rep.latMin  = (rx.rep.frames == 0) ? added : min(rx.rep.latMin, added);
+    rx.rep.latMax  = max(rx.rep.latMax, added);
+    rx.rep.latSum += added;
+    rx.rep.latLast = added;
+    rx.rep.frames++;
+    rx.rep.bytes  += len;
+    updateLED('2');                                                 // Blink LED.
+}
+
+/**
+ * ------------------------------------------------
+ *      Receiver role: clear stats.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-01:30am] New.
+ * @see    initVars().
+ * @see    checkSerialUSB().
+ */
+void rxClear() {
+    memset(&rx, 0, sizeof(rx));
+    rx.lastEpoch = -1;
+    rx.since     = millis();
+}
+
+/**
+ * ------------------------------------------------
+ *      Receiver role: display stats.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-01:30am] New.
+ * @see    checkSerialUSB().
+ */
+void showRx() {
+
+    // -- Local vars. --
+    uint32_t nowMs = millis();
+    uint32_t seen  = rx.epochs + rx.epochsLost;
+
+    Serial.printf("\nReceiver (role %s, hop %s), last %lu s: %lu bytes in, %lu frames ok, %lu CRC errors, "
+                  "%lu poisoned.\n", ROLE_NAMES[role], HOP_NAMES[config.hop], (unsigned long) ((nowMs - rx.since) / 1000),
+                  (unsigned long) rx.bytesIn, (unsigned long) rx.framesOk, (unsigned long) rx.crcErrors,
+                  (unsigned long) rx.poisoned);
+    if (role == ROLE_REPEATER) {
+        Serial.printf("Repeated on link 2: %lu frames, %lu bytes, %lu dropped (queue > %lu ms). Added latency ms: "
+                      "last %lu, min %lu, avg %lu, max %lu.\n",
+                      (unsigned long) rx.rep.frames, (unsigned long) rx.rep.bytes, (unsigned long) rx.rep.queueDrops,
+                      (unsigned long) RX_MAX_AGE, (unsigned long) rx.rep.latLast, (unsigned long) rx.rep.latMin,
+                      (unsigned long) ((rx.rep.frames > 0) ? rx.rep.latSum / rx.rep.frames : 0),
+                      (unsigned long) rx.rep.latMax);
+    } else {
+        Serial.printf("Out to GNSS: %lu frames, %lu bytes, %lu dropped (Serial0 TX full).\n",
+                      (unsigned long) rx.framesOut, (unsigned long) rx.bytesOut, (unsigned long) rx.outDrops);
+    }
+    Serial.printf("Dropped: %lu duplicates/echoes, %lu stale (> %lu ms behind newest epoch).\n", (unsigned long) rx.dups,
+                  (unsigned long) rx.stale, (unsigned long) RX_MAX_AGE);
+    Serial.printf("Age %lu ms (longest gap %lu ms). Epochs %lu, lost %lu (%lu.%lu%%), period %lu ms.\n",
+                  (unsigned long) ((rx.framesOk > 0) ? nowMs - rx.lastFrame : 0), (unsigned long) rx.maxGap,
+                  (unsigned long) rx.epochs, (unsigned long) rx.epochsLost,
+                  (unsigned long) ((seen > 0) ? rx.epochsLost * 100 / seen : 0),
+                  (unsigned long) ((seen > 0) ? rx.epochsLost * 1000 / seen % 10 : 0), (unsigned long) rx.periodMs);
+    Serial.println("  Under(ms)  Gaps");
+    for (size_t i = 0; i < WDOG_BUCKETS; i++) {
+        if (WDOG_BUCKET_MS[i] == UINT32_MAX) {
+            Serial.printf("  %9s  %4lu\n", "more", (unsigned long) rx.gapHist[i]);
+        } else {
+            Serial.printf("  %9lu  %4lu\n", (unsigned long) WDOG_BUCKET_MS[i], (unsigned long) rx.gapHist[i]);
+        }
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      CRC-24Q of a buffer.
+ * ------------------------------------------------
+ *
+ * @param  const uint8_t * data Bytes.
+ * @param  size_t          len  Byte count.
+ * @return uint32_t CRC-24Q (initial 0).
+ * @since  3.1.1 [2026-10-18-12:30am] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    initCrc24q().
+ */
+uint32_t HOT_FN crc24q(const uint8_t * data, size_t len) {
+
+    // -- Local vars. --
+    uint32_t crc = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        crc = ((crc << 8) ^ crc24qTable[((crc >> 16) ^ data[i]) & 0xff]) & 0xffffff;
+    }
+    return crc;
+}
+
+/**
+ * ------------------------------------------------
+ *      CRC-16/CCITT of a buffer (compact hop).
+ * ------------------------------------------------
+ *
+ * @param  uint16_t        crc  Running CRC (0xffff to start).
+ * @param  const uint8_t * data Bytes.
+ * @param  size_t          len  Byte count.
+ * @return uint16_t CRC-16, continued over data.
+ * @since  3.1.1 [2026-10-18-12:30am] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    initCrc24q().
+ */
+uint16_t HOT_FN crc16(uint16_t crc, const uint8_t * data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc = (crc << 8) ^ crc16Table[((crc >> 8) ^ data[i]) & 0xff];
+    }
+    return crc;
+}
+
+/**
+ * ------------------------------------------------
+ *      Check telemetry. Inject into idle airtime.
+ * ------------------------------------------------
+ *
+ * Every config.telemPeriod, once the epoch burst is over (parser between frames, no input pending, input quiet for
+ * TELEM_QUIET, modelled HC-12 queue drained), send one RTCM 1029 frame. The next burst is most of an epoch away, so
+ * corrections never wait behind telemetry. While the ZED is stalled the radio is idle & telemetry still goes out -
+ * the rover can tell "base silent" from "relay/radio down".
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-01:30pm] New.
+ * @since  3.1.0 [2026-10-17-11:30pm] Compact hop encoding.
+ * @see    buildTelemetry().
+ * @see    loop().
+ */
+void checkTelemetry() {
+
+    // -- Local vars. --
+    int64_t  now     = esp_timer_get_time();
+    uint32_t nowMs   = (uint32_t) (now / 1000);
+    uint16_t frameLen;
+
+    if ((now - rtcmLastByte) / 1000 >= INPUT_STALL) {               // Input stall flags.
+        telemStall |= TELEM_STALL_NOW | TELEM_STALL_WIN;
+    } else {
+        telemStall &= ~TELEM_STALL_NOW;
+    }
+    if ((config.telemPeriod == 0) || (nowMs - telemLast < config.telemPeriod) || rtcmInFrame || (Serial0.available() > 0) ||
+        ((now - rtcmLastByte) / 1000 < TELEM_QUIET) || (now < radioAirUntil)) {
+        return;
+    }
+    frameLen = buildTelemetry(nowMs);
+    telemAirBusy = 0;
+    if (config.hop == HOP_COMPACT) {
+        hopHeader(frameLen - 6, LINK_BOTH);
+        hopPayload(&telemFrame[3], frameLen - 6);
+        hopTrailer(true);
+    } else {
+        radioWrite(telemFrame, frameLen, LINK_BOTH);
+    }
+    flightRec.now.telemetryOut++;
+    telemLast        = nowMs;
+    telemRxHighWater = 0;
+    telemStall      &= TELEM_STALL_NOW;
+}
+
+/**
+ * ------------------------------------------------
+ *      Build telemetry frame.
+ * ------------------------------------------------
+ *
+ * RTCM 1029: type (12), station ID (12), MJD (16), UTC second of day (17), characters (7), UTF-8 units (8), text.
+ * MJD & time are 0 (no time source). Text (ASCII):
+ *   GRR1 n=<seq> u=<uptime s> fi=<frames in> fo=<relayed> dc=<CRC errors> dr=<resyncs> do=<overflows>
+ *        dd=<decimated> q=<RX queue high-water bytes> a=<airtime %> st=<stall flags>
+ * Counters are since boot; q, a & st cover the interval since the last telemetry frame.
+ *
+ * @param  uint32_t nowMs Now (ms since boot).
+ * @return uint16_t Frame length.
+ * @since  3.1.0 [2026-10-17-01:30pm] New.
+ * @since  3.1.0 [2026-10-17-09:00pm] bitWriter.
+ * @see    checkTelemetry().
+ * @see    tools/rtcm_telemetry.py.
+ */
+uint16_t buildTelemetry(uint32_t nowMs) {
+
+    // -- Local vars. --
+    uint32_t elapsed = max(nowMs - telemLast, (uint32_t) 1);
+    uint16_t  textLen;
+    uint16_t  payloadLen;
+    uint32_t  crc;
+    bitWriter w;
+
+    telemSeq++;
+    textLen = snprintf(telemText, sizeof(telemText),
+                       "GRR1 n=%lu u=%lu fi=%lu fo=%lu dc=%lu dr=%lu do=%lu dd=%lu q=%u a=%lu st=%u",
+                       (unsigned long) telemSeq, (unsigned long) (nowMs / 1000),
+                       (unsigned long) flightRec.now.framesIn, (unsigned long) flightRec.now.framesOut,
+                       (unsigned long) flightRec.now.crcErrors, (unsigned long) flightRec.now.resyncs,
+                       (unsigned long) flightRec.now.rxOverflows, (unsigned long) flightRec.now.decimated,
+                       (unsigned) telemRxHighWater,
+                       (unsigned long) min((uint32_t) 100, telemAirBusy / 10 / elapsed), (unsigned) telemStall);
+    textLen    = min(textLen, (uint16_t) (sizeof(telemText) - 1));
+    payloadLen = 9 + textLen;
+    bitsInitWriter(&w, telemFrame, sizeof(telemFrame));
+    bitsPut(&w,  8, RTCM_PREAMBLE);
+    bitsPut(&w,  6, 0);                                             // Reserved.
+    bitsPut(&w, 10, payloadLen);
+    bitsPut(&w, 12, TELEM_MSG_TYPE);
+    bitsPut(&w, 12, rtcmStationId);
+    bitsPut(&w, 16, 0);                                             // MJD.
+    bitsPut(&w, 17, 0);                                             // UTC second of day.
+    bitsPut(&w,  7, textLen);                                       // Characters.
+    bitsPut(&w,  8, textLen);                                       // UTF-8 code units.
+    bitsFlush(&w);
+    memcpy(&telemFrame[12], telemText, textLen);
+    crc = crc24q(telemFrame, 3 + payloadLen);
+    telemFrame[3 + payloadLen]     = (uint8_t) (crc >> 16);
+    telemFrame[3 + payloadLen + 1] = (uint8_t) (crc >> 8);
+    telemFrame[3 + payloadLen + 2] = (uint8_t) crc;
+    return 3 + payloadLen + 3;
+}
+
+
+/**
+ * ------------------------------------------------
+ *      Display telemetry.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-01:30pm] New.
+ * @see    checkSerialUSB().
+ */
+void showTelemetry() {
+    Serial.printf("\nTelemetry: RTCM %u every %lu s, %lu sent.\n", (unsigned) TELEM_MSG_TYPE,
+                  (unsigned long) (config.telemPeriod / 1000), (unsigned long) flightRec.now.telemetryOut);
+    Serial.printf("Last: \"%s\"\n", telemText);
+}
+
+/**
+ * ------------------------------------------------
+ *      Write to HC-12 radio(s).
+ * ------------------------------------------------
+ *
+ * All radio output goes through here so the per link airtime models (radioLinkUntil, radioAirUntil = both drained)
+ * & telemetry airtime (link 1) stay exact. Route is ignored (link 1 only) unless the second radio is on.
+ *
+ * @param  const uint8_t * data  Bytes.
+ * @param  size_t          len   Byte count.
+ * @param  uint8_t         links LINK_1, LINK_2 or LINK_BOTH.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-03:00pm] New.
+ * @since  3.1.0 [2026-10-17-10:00pm] Per link routing & pacing.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    checkRTCMtoRadio().
+ * @see    checkTelemetry().
+ */
+void HOT_FN radioWrite(const uint8_t * data, size_t len, uint8_t links) {
+    int64_t now = esp_timer_get_time();
+    if (selfTest.mode != ST_OFF) {                                  // Synthetic RTCM3 never goes on air.
+        selfTest.sunk += len;
+        return;
+    }
+    if (!RADIO2_BUILD || (config.radio2 == RADIO2_OFF)) {
+        links = LINK_1;
+    }
+    if (links & LINK_1) {
+        Serial1.write(data, len);                                   // Write to Serial1 (HC-12 radio).
+        radioLinkUntil[0] = max(radioLinkUntil[0], now) + (int64_t) len * radioByteUs;
+        radioLinkBytes[0] += len;
+        telemAirBusy      += len * radioByteUs;
+    }
+#if GR_RADIO2
+    if (links & LINK_2) {
+        SerialLP.write(data, len);                                  // Write to SerialLP (2nd HC-12 radio).
+        radioLinkUntil[1] = max(radioLinkUntil[1], now) + (int64_t) len * radioByteUs;
+        radioLinkBytes[1] += len;
+    }
+#endif
+    radioAirUntil = max(radioLinkUntil[0], radioLinkUntil[1]);
+}
+
+/**
+ * ------------------------------------------------
+ *      Compact hop frame: header.
+ * ------------------------------------------------
+ *
+ * Compact radio hop (config hop = 1): [length][payload][CRC-16], length = payload bytes, 1 byte if < 128, else 2
+ * (low 7 bits | 0x80, then high 3 bits). The preamble & reserved bits (always 0xd3, 000000) & CRC-24Q are dropped:
+ * 3 bytes saved on short frames (1005, 1230, ...), 2 on MSM. CRC-16/CCITT (init 0xffff) covers length & payload.
+ * The rover rebuilds 0xd3, 000000, 10 bit length, payload & CRC-24Q - bit-exact, since only CRC-24Q valid frames
+ * get a valid CRC-16. Payload bytes still cut through, so a CRC-24Q failure is only known at the end: the frame is
+ * then poisoned (CRC-16 inverted) & the rover drops it. No preamble: the rover syncs at a quiet gap & on CRC-16 +
+ * known message type. See tools/rtcm_hop.py.
+ *
+ * @param  uint16_t payloadLen RTCM3 payload bytes.
+ * @param  uint8_t  links      LINK_1, LINK_2 or LINK_BOTH.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:30pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    checkRTCMtoRadio().
+ * @see    checkTelemetry().
+ */
+void HOT_FN hopHeader(uint16_t payloadLen, uint8_t links) {
+
+    // -- Local vars. --
+    uint8_t header[2];
+    uint8_t len = 0;
+
+    hop.crc   = 0xffff;
+    hop.links = links;
+    if (payloadLen < 0x80) {
+        header[len++] = (uint8_t) payloadLen;
+    } else {
+        header[len++] = (uint8_t) (payloadLen | 0x80);
+        header[len++] = (uint8_t) (payloadLen >> 7);
+    }
+    hopPayload(header, len);
+}
+
+/**
+ * ------------------------------------------------
+ *      Compact hop frame: bytes.
+ * ------------------------------------------------
+ *
+ * @param  const uint8_t * data Bytes.
+ * @param  size_t          len  Byte count.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:30pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    hopHeader().
+ */
+void HOT_FN hopPayload(const uint8_t * data, size_t len) {
+    hop.crc = crc16(hop.crc, data, len);
+    radioWrite(data, len, hop.links);
+}
+
+/**
+ * ------------------------------------------------
+ *      Compact hop frame: CRC-16.
+ * ------------------------------------------------
+ *
+ * @param  bool crcOk Input CRC-24Q passed (else poison).
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:30pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    hopHeader().
+ */
+void HOT_FN hopTrailer(bool crcOk) {
+
+    // -- Local vars. --
+    uint16_t crc = crcOk ? hop.crc : (uint16_t) ~hop.crc;
+    uint8_t  trailer[2] = {(uint8_t) (crc >> 8), (uint8_t) crc};
+
+    radioWrite(trailer, 2, hop.links);
+    hop.frames++;
+    if (!crcOk) {
+        hop.poisoned++;
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Compact hop length.
+ * ------------------------------------------------
+ *
+ * @param  uint16_t frameLen RTCM3 frame length.
+ * @return uint16_t Compact frame length.
+ * @since  3.1.0 [2026-10-17-11:30pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    hopHeader().
+ */
+uint16_t HOT_FN hopLen(uint16_t frameLen) {
+    return frameLen - 6 + ((frameLen - 6 < 0x80) ? 1 : 2) + 2;
+}
+
+/**
+ * ------------------------------------------------
+ *      Display radio hop encoding.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:30pm] New.
+ * @see    checkSerialUSB().
+ */
+void showHop() {
+    Serial.printf("\nRadio hop: %s (cfg hop 0 = rtcm, 1 = compact).\n", HOP_NAMES[config.hop]);
+    Serial.printf("Compact %s %lu of %lu relayed bytes (%lu%%), %lu bytes/epoch (max %lu).\n",
+                  ((config.hop == HOP_COMPACT) ? "saved" : "would save"), (unsigned long) hop.saved,
+                  (unsigned long) hop.rtcmBytes,
+                  (unsigned long) ((hop.rtcmBytes > 0) ? (uint64_t) hop.saved * 100 / hop.rtcmBytes : 0),
+                  (unsigned long) hop.avgSaved, (unsigned long) hop.maxSaved);
+    Serial.printf("Frames sent compact %lu, poisoned (CRC-24Q failed) %lu.\n", (unsigned long) hop.frames,
+                  (unsigned long) hop.poisoned);
+}
+
+/**
+ * ------------------------------------------------
+ *      Plan constellation split between links.
+ * ------------------------------------------------
+ *
+ * Greedy: planned bytes per epoch (avgBytes / ratio), largest first, each to the lighter link. Non-MSM frames go to
+ * both links, so they don't change the balance.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-10:00pm] New.
+ * @see    decimEpochDone().
+ */
+void radioSplitPlan() {
+
+    // -- Local vars. --
+    uint32_t linkLoad[RADIO_LINKS] = {0, 0};
+    bool     placed[GNSS_NUM];
+    int8_t   c;
+
+    memset(placed, 0, sizeof(placed));
+    while (true) {
+        c = -1;                                                     // Largest unplaced.
+        for (size_t i = 0; i < GNSS_NUM; i++) {
+            if (!placed[i] && ((c < 0) || (decim.avgBytes[i] / decim.ratio[i] > decim.avgBytes[c] / decim.ratio[c]))) {
+                c = i;
+            }
+        }
+        if (c < 0) {
+            return;
+        }
+        placed[c]   = true;
+        gnssLink[c] = (linkLoad[0] <= linkLoad[1]) ? LINK_1 : LINK_2;
+        linkLoad[(gnssLink[c] == LINK_1) ? 0 : 1] += decim.avgBytes[c] / decim.ratio[c];
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Input stall & Serial1 TX stall watchdog.
+ * ------------------------------------------------
+ *
+ * Input: once the ZED has sent anything, a stall is input quiet for 1.5 epoch periods + WDOG_MARGIN (INPUT_STALL if
+ * the cadence is unknown), i.e. the next burst is missing. Serial0 is then restarted in place (restartSerial0(), no
+ * heap churn) & the parser resynced, retrying with doubling backoff (to WDOG_BACKOFF_MAX) while still quiet. Time to
+ * detect (from when the burst was due) & time to recover (detect to first byte) go into histograms.
+ * Serial1: restarted in place (restartSerial1()) if its TX space has not moved for WDOG_TX_SLACK after the airtime
+ * model says it drained; the model then restarts from the bytes still queued.
+ * Both are logged in the flight recorder.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:00pm] New.
+ * @since  3.1.1 [2026-10-18-05:00am] Serial0 restarted in place, not end() / begin().
+ * @since  3.1.1 [2026-10-18-06:30am] Serial1 restarted in place too.
+ * @see    loop().
+ */
+void checkWatchdog() {
+
+    // -- Local vars. --
+    uint32_t nowMs = millis();
+    int64_t  now;
+    uint32_t quiet;
+    uint32_t limit;
+    uint32_t space;
+
+    if ((nowMs - wdog.lastCheck < WDOG_CHECK) || (bootTime[BOOT_FIRST_IN] == 0) || (update.stage == UPDATE_REBOOT)) {
+        return;
+    }
+    wdog.lastCheck = nowMs;
+    now   = esp_timer_get_time();
+    quiet = (uint32_t) ((now - rtcmLastByte) / 1000);
+    limit = (decim.periodMs > 0) ? decim.periodMs + decim.periodMs / 2 + WDOG_MARGIN : INPUT_STALL;
+
+    // - Input. -
+    if (wdog.stalled && (quiet < nowMs - wdog.detectedAt)) {        // Byte in since detection - recovered.
+        wdog.stalled     = false;
+        wdog.lastRecover = nowMs - wdog.detectedAt - quiet;
+        wdogHistogram(wdog.recoverHist, wdog.lastRecover);
+    } else if (!wdog.stalled && (quiet >= limit)) {                 // Stall.
+        wdog.stalled    = true;
+        wdog.detectedAt = nowMs;
+        wdog.lastDetect = quiet - ((decim.periodMs > 0) ? decim.periodMs : 0);
+        wdogHistogram(wdog.detectHist, wdog.lastDetect);
+        wdog.backoff    = max(limit, (uint32_t) 1000);
+        wdog.nextReinit = nowMs;
+    }
+    if (wdog.stalled && ((int32_t) (nowMs - wdog.nextReinit) >= 0)) {
+        restartSerial0();
+        if (config.autobaud && (baud.stage == BAUD_LOCKED)) {       // The ZED may come back at another speed.
+            baudScan(true);
+        }
+        rtcmResync = true;
+        wdog.rxReinits++;
+        recorderFrame(nowMs, 0, 0, true, FR_REINIT, nowMs);
+        wdog.nextReinit = nowMs + wdog.backoff;
+        wdog.backoff    = min(wdog.backoff * 2, WDOG_BACKOFF_MAX);
+    }
+
+    // - Serial1 TX. -
+    space = Serial1.availableForWrite();
+    if ((now > radioLinkUntil[0] + (int64_t) WDOG_TX_SLACK * 1000) && (space == wdog.txSpace) && (space < wdog.txSpaceMax)) {
+        restartSerial1();
+        radioLinkUntil[0] = now + (int64_t) (wdog.txSpaceMax - space) * radioByteUs;   // Still queued.
+        wdog.txReinits++;
+        recorderFrame(nowMs, 1, 0, true, FR_REINIT, nowMs);
+    }
+    if (now > radioLinkUntil[0] + (int64_t) WDOG_TX_SLACK * 1000) {
+        wdog.txSpace = space;                                       // Only compare samples taken after the drain.
+    } else {
+        wdog.txSpace = UINT32_MAX;
+    }
+    wdog.txSpaceMax = max(wdog.txSpaceMax, space);
+}
+
+/**
+ * ------------------------------------------------
+ *      Watchdog histogram add.
+ * ------------------------------------------------
+ *
+ * @param  uint32_t * hist Histogram (WDOG_BUCKETS).
+ * @param  uint32_t   ms   Sample (ms).
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:00pm] New.
+ */
+void wdogHistogram(uint32_t * hist, uint32_t ms) {
+    for (size_t i = 0; i < WDOG_BUCKETS; i++) {
+        if (ms < WDOG_BUCKET_MS[i]) {
+            hist[i]++;
+            return;
+        }
+    }
+    hist[WDOG_BUCKETS - 1]++;
+}
+
+/**
+ * ------------------------------------------------
+ *      Display watchdog.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-11:00pm] New.
+ * @see    checkSerialUSB().
+ */
+void showWatchdog() {
+    Serial.printf("\nWatchdog: input %s, stall after %lu ms quiet, Serial0 re-inits %lu, Serial1 re-inits %lu.\n",
+                  (wdog.stalled ? "STALLED" : "ok"),
+                  (unsigned long) ((decim.periodMs > 0) ? decim.periodMs + decim.periodMs / 2 + WDOG_MARGIN : INPUT_STALL),
+                  (unsigned long) wdog.rxReinits, (unsigned long) wdog.txReinits);
+    Serial.printf("Last: detect %lu ms, recover %lu ms. \"wdog rx\" / \"wdog tx\" inject a stall.\n",
+                  (unsigned long) wdog.lastDetect, (unsigned long) wdog.lastRecover);
+    Serial.println("  Under(ms)  Detect  Recover");
+    for (size_t i = 0; i < WDOG_BUCKETS; i++) {
+        if (WDOG_BUCKET_MS[i] == UINT32_MAX) {
+            Serial.printf("  %9s  %6lu  %7lu\n", "more", (unsigned long) wdog.detectHist[i],
+                          (unsigned long) wdog.recoverHist[i]);
+        } else {
+            Serial.printf("  %9lu  %6lu  %7lu\n", (unsigned long) WDOG_BUCKET_MS[i], (unsigned long) wdog.detectHist[i],
+                          (unsigned long) wdog.recoverHist[i]);
+        }
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Display radio links.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-10:00pm] New.
+ * @see    checkSerialUSB().
+ */
+void showRadio() {
+
+    // -- Local vars. --
+    int64_t now = esp_timer_get_time();
+
+    Serial.printf("\nSecond radio: %s%s.\n", RADIO2_NAMES[config.radio2],
+                  (RADIO2_BUILD ? "" : " (not in this build, GR_RADIO2 = 0)"));
+    for (size_t i = 0; i < RADIO_LINKS; i++) {
+        Serial.printf("  Link %u (%s): %lu bytes, queue drains in %lu ms.\n", (unsigned) (i + 1),
+                      (i == 0 ? "Serial1" : "SerialLP"), (unsigned long) radioLinkBytes[i],
+                      (unsigned long) ((radioLinkUntil[i] > now) ? (radioLinkUntil[i] - now) / 1000 : 0));
+    }
+    if (config.radio2 == RADIO2_SPLIT) {
+        Serial.print("  Split:");
+        for (size_t i = 0; i < GNSS_NUM; i++) {
+            if (decim.avgBytes[i] > 0) {
+                Serial.printf(" %s->%u", GNSS_NAMES[i], (unsigned) ((gnssLink[i] == LINK_1) ? 1 : 2));
+            }
+        }
+        Serial.println();
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      MSM constellation.
+ * ------------------------------------------------
+ *
+ * @param  uint16_t msgType Message type.
+ * @return int8_t Constellation (0 GPS, 1 GLO, 2 GAL, 3 SBAS, 4 QZSS, 5 BDS, 6 NavIC), -1 if not MSM1-7.
+ * @since  3.1.0 [2026-10-17-03:00pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    rtcmDecide().
+ */
+int8_t HOT_FN rtcmMsmGnss(uint16_t msgType) {
+    if ((msgType < 1071) || (msgType > 1137) || ((msgType - 1071) % 10 > 6)) {
+        return -1;
+    }
+    return (msgType - 1071) / 10;
+}
+
+/**
+ * ------------------------------------------------
+ *      Relay or decimate frame.
+ * ------------------------------------------------
+ *
+ * Called once per frame with the first RTCM_DECIDE_AT bytes (or the whole frame if shorter). Non-MSM frames are
+ * always relayed. An MSM opens a new epoch after the last MSM of the previous epoch (multiple message bit clear)
+ * or a DECIM_EPOCH_GAP silence; each constellation is then sent when (epoch + phase) % ratio == 0, so all MSMs of a
+ * constellation in an epoch share one decision. The MSM with the multiple message bit clear (frame byte 9 & 0x02,
+ * in by RTCM_DECIDE_AT) is always relayed: it is the rover's epoch terminator, & cut-through cannot set the bit on
+ * an earlier MSM once that is on air.
+ *
+ * @param  uint16_t byteCount Bytes held.
+ * @param  int64_t  now       Now (us).
+ * @return bool Relay.
+ * @since  3.1.0 [2026-10-17-03:00pm] New.
+ * @since  3.1.0 [2026-10-17-04:15pm] Epoch time & clock offset sample.
+ * @since  3.1.0 [2026-10-17-10:00pm] Link route (rtcmRoute).
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @since  3.1.1 [2026-10-18-04:00am] Forecast plan at the first MSM of an epoch.
+ * @since  3.1.1 [2026-10-18-05:00am] Epoch closed in checkFrameDone() (end of epoch planning off the hot path).
+ * @since  3.1.1 [2026-10-18-06:00am] Last MSM of the epoch never decimated or skipped.
+ * @since  3.1.1 [2026-10-18-06:30am] No forecast plan (fcast.skip) - it did not beat the averages.
+ * @see    checkRTCMtoRadio().
+ * @see    decimEpochDone().
+ */
+bool HOT_FN rtcmDecide(uint16_t byteCount, int64_t now) {
+
+    // -- Local vars. --
+    int8_t gnss;
+
+    rtcmRoute = LINK_BOTH;                                          // Non-MSM & duplicate mode.
+    if (byteCount < RTCM_DECIDE_AT) {                               // Too short for an MSM.
+        rtcmFrameEpoch = -1;
+        return true;
+    }
+    gnss = rtcmMsmGnss(rtcm3GetMessageType(rtcmSentence));
+    if (gnss < 0) {
+        rtcmFrameEpoch = -1;
+        return true;
+    }
+    if (config.radio2 == RADIO2_SPLIT) {
+        rtcmRoute = gnssLink[gnss];
+    }
+    rtcmFrameEpoch = (selfTest.mode == ST_OFF) ? msmEpochGps(gnss) : -1;   // Self test epochs stay out of latency.
+    if (!decim.epochOpen || ((now - decim.lastMsm) / 1000 > DECIM_EPOCH_GAP)) {     // New epoch.
+        if (rtcmFrameEpoch >= 0) {                                  // Clock offset sample (first MSM of epoch).
+            latencySample(now - rtcmFrameEpoch * 1000);
+        }
+        if (decim.epochOpen) {                                      // Never closed (flash code - checkFrameDone() does
+            fcastEpochDone();                                       // this at the gap, so only if loop() lagged).
+            decimEpochDone();
+        }
+        if (decim.epochStart != 0) {
+            uint32_t period = (uint32_t) ((now - decim.epochStart) / 1000);
+            if (period < 30000) {                                   // Ignore restarts after long gaps.
+                decim.periodMs += ((int32_t) period - (int32_t) decim.periodMs) / 4;
+            }
+        }
+        decim.epochStart = now;
+        decim.epochOpen  = true;
+        decim.epoch++;
+    }
+    decim.lastMsm = now;
+    if (!(rtcmSentence[9] & 0x02)) {                                // Multiple message bit clear - epoch terminator.
+        return true;
+    }
+    return !decim.enabled || (((decim.epoch + decim.phase[gnss]) % decim.ratio[gnss]) == 0);
+}
+
+/**
+ * ------------------------------------------------
+ *      Epoch done. Adapt decimation.
+ * ------------------------------------------------
+ *
+ * Folds the epoch's measured bytes (sent or not) into per constellation averages, then moves at most one ratio one
+ * step: up for the lowest priority constellation if the plan does not fit the budget, down for the highest priority
+ * decimated one if the result fits with DECIM_RELAX_PCT headroom. Budget = Serial1 bytes per epoch period *
+ * DECIM_BUDGET_PCT - non-MSM bytes (1005, 1230, telemetry ... are never decimated).
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-03:00pm] New.
+ * @since  3.1.0 [2026-10-17-11:30pm] Compact hop saving per epoch.
+ * @since  3.1.1 [2026-10-18-03:30am] Budget in decimBudget().
+ * @see    checkFrameDone().
+ * @see    decimPhases().
+ */
+void decimEpochDone() {
+
+    // -- Local vars. --
+    uint32_t load = 0;
+    int8_t   c;
+
+    decim.epochOpen = false;
+    for (size_t i = 0; i < GNSS_NUM; i++) {
+        decim.avgBytes[i] += ((int32_t) decim.epochBytes[i] - (int32_t) decim.avgBytes[i]) / 4;
+        decim.epochBytes[i] = 0;
+        load += decim.avgBytes[i] / decim.ratio[i];
+    }
+    decim.avgOther  += ((int32_t) decim.otherBytes - (int32_t) decim.avgOther) / 4;
+    decim.otherBytes = 0;
+    hop.avgSaved    += ((int32_t) hop.epochSaved - (int32_t) hop.avgSaved) / 4;
+    hop.maxSaved     = max(hop.maxSaved, hop.epochSaved);
+    hop.epochSaved   = 0;
+    decimBudget();
+    if (config.radio2 == RADIO2_SPLIT) {                            // MSM spread over both links.
+        radioSplitPlan();
+    }
+    if (load > decim.budget) {                                      // Does not fit - decimate lowest priority more.
+        for (int8_t p = GNSS_NUM - 1; p >= 0; p--) {
+            c = DECIM_PRIORITY[p];
+            if ((decim.avgBytes[c] > 0) && (decim.ratio[c] < DECIM_MAX_RATIO)) {
+                decim.ratio[c]++;
+                decimPhases();
+                return;
+            }
+        }
+    } else {                                                        // Fits - relax highest priority decimated.
+        for (int8_t p = 0; p < GNSS_NUM; p++) {
+            c = DECIM_PRIORITY[p];
+            if (decim.ratio[c] > 1) {
+                load = load - decim.avgBytes[c] / decim.ratio[c] + decim.avgBytes[c] / (decim.ratio[c] - 1);
+                if (load * 100 <= decim.budget * DECIM_RELAX_PCT) {
+                    decim.ratio[c]--;
+                    decimPhases();
+                }
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Decimation budget.
+ * ------------------------------------------------
+ *
+ * MSM bytes per epoch that fit: Serial1 bytes per epoch period (at the running speed) * DECIM_BUDGET_PCT - non-MSM
+ * bytes, times the links when MSMs are split.
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-03:30am] New. From decimEpochDone().
+ * @since  3.1.1 [2026-10-18-05:00am] Running Serial1 speed (radioSpeed), not the pending config.
+ * @see    decimEpochDone().
+ * @see    profileSeed().
+ */
+void decimBudget() {
+    uint32_t capacity = (radioSpeed / 10) * decim.periodMs / 1000 * DECIM_BUDGET_PCT / 100;
+    decim.budget = (capacity > decim.avgOther) ? capacity - decim.avgOther : 0;
+    if (config.radio2 == RADIO2_SPLIT) {
+        decim.budget *= RADIO_LINKS;
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Plan decimation phases.
+ * ------------------------------------------------
+ *
+ * Greedy: decimated constellations, largest first, each take the phase that keeps the heaviest epoch of the
+ * DECIM_CYCLE cycle lightest - so every epoch carries roughly the same number of bytes.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-03:00pm] New.
+ * @see    decimEpochDone().
+ */
+void decimPhases() {
+
+    // -- Local vars. --
+    uint32_t slot[DECIM_CYCLE];                                     // Bytes per epoch of the cycle.
+    bool     placed[GNSS_NUM];
+    uint32_t worst;
+    uint32_t bestWorst;
+    uint8_t  bestPhase;
+    int8_t   c;
+
+    memset(placed, 0, sizeof(placed));
+    for (size_t s = 0; s < DECIM_CYCLE; s++) {                      // Every epoch constellations.
+        slot[s] = 0;
+        for (size_t i = 0; i < GNSS_NUM; i++) {
+            if (decim.ratio[i] == 1) {
+                slot[s] += decim.avgBytes[i];
+                placed[i] = true;
+            }
+        }
+    }
+    while (true) {
+        c = -1;                                                     // Largest unplaced.
+        for (size_t i = 0; i < GNSS_NUM; i++) {
+            if (!placed[i] && ((c < 0) || (decim.avgBytes[i] > decim.avgBytes[c]))) {
+                c = i;
+            }
+        }
+        if (c < 0) {
+            return;
+        }
+        bestWorst = UINT32_MAX;
+        bestPhase = 0;
+        for (uint8_t p = 0; p < decim.ratio[c]; p++) {
+            worst = 0;
+            for (size_t s = 0; s < DECIM_CYCLE; s++) {
+                worst = max(worst, slot[s] + ((((s + p) % decim.ratio[c]) == 0) ? decim.avgBytes[c] : 0));
+            }
+            if (worst < bestWorst) {
+                bestWorst = worst;
+                bestPhase = p;
+            }
+        }
+        decim.phase[c] = bestPhase;
+        for (size_t s = 0; s < DECIM_CYCLE; s++) {
+            if (((s + bestPhase) % decim.ratio[c]) == 0) {
+                slot[s] += decim.avgBytes[c];
+            }
+        }
+        placed[c] = true;
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Display decimation.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-03:00pm] New.
+ * @see    checkSerialUSB().
+ */
+void showDecimation() {
+
+    // -- Local vars. --
+    uint32_t load = 0;
+
+    Serial.printf("Epoch %lu, period %lu ms, MSM budget %lu bytes/epoch, other %lu bytes/epoch.\n",
+                  (unsigned long) decim.epoch, (unsigned long) decim.periodMs, (unsigned long) decim.budget,
+                  (unsigned long) decim.avgOther);
+    Serial.println("  GNSS   Bytes/epoch  Ratio  Phase");
+    for (size_t i = 0; i < GNSS_NUM; i++) {
+        if (decim.avgBytes[i] == 0) {
+            continue;
+        }
+        load += decim.avgBytes[i] / decim.ratio[i];
+        Serial.printf("  %-6s %11lu  1/%u   %5u\n", GNSS_NAMES[i], (unsigned long) decim.avgBytes[i],
+                      (unsigned) decim.ratio[i], (unsigned) decim.phase[i]);
+    }
+    Serial.printf("Planned MSM load %lu bytes/epoch, %lu decimated frames.\n", (unsigned long) load,
+                  (unsigned long) flightRec.now.decimated);
+}
+
+/**
+ * ------------------------------------------------
+ *      Base profile - frame.
+ * ------------------------------------------------
+ *
+ * Learns what the base sends without being told: each CRC-valid frame is filed by message type; frames of a type in
+ * one epoch (decim.epoch) are one occurrence, giving the type's period (between occurrence starts) & air bytes per
+ * occurrence. After PROFILE_EPOCHS epochs the profile forecasts the link load & seeds decimation (profileSeed()).
+ * A new message type or base station ID starts learning again.
+ *
+ * @param  uint16_t type    RTCM3 message type.
+ * @param  int8_t   gnss    MSM constellation, -1 = not MSM.
+ * @param  uint16_t airLen  Frame bytes on air.
+ * @param  uint16_t station Station ID (1005/1006/MSM), else 0.
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-03:30am] New.
+ * @see    checkFrameDone().
+ */
+void profileFrame(uint16_t type, int8_t gnss, uint16_t airLen, uint16_t station) {
+
+    // -- Local vars. --
+    uint32_t      nowMs = millis();
+    profileType * t     = NULL;
+    uint32_t      period;
+
+    if ((station != 0) && (station != profile.station)) {          // Another base.
+        if (profile.station != 0) {
+            profileClear();
+        }
+        profile.station = station;
+    }
+    for (uint8_t i = 0; i < profile.count; i++) {
+        if (profile.types[i].type == type) {
+            t = &profile.types[i];
+            break;
+        }
+    }
+    if (t == NULL) {                                                // New type.
+        if (profile.count == PROFILE_TYPES) {
+            profile.untracked++;
+            return;
+        }
+        t = &profile.types[profile.count++];
+        memset(t, 0, sizeof(*t));
+        t->type    = type;
+        t->gnss    = gnss;
+        t->firstMs = nowMs;
+        t->epoch   = decim.epoch - 1;
+        if (profile.learned) {                                      // Base reconfigured - learn again.
+            profile.learned    = false;
+            profile.startEpoch = decim.epoch;
+            profile.relearns++;
+        }
+    }
+    if (t->epoch != decim.epoch) {                                  // New occurrence.
+        if (t->occurrences > 0) {
+            period      = nowMs - t->startMs;
+            t->periodMs = (t->periodMs == 0) ? period : t->periodMs + ((int32_t) period - (int32_t) t->periodMs) / 4;
+            profileSize(t);
+        }
+        t->occurrences++;
+        t->epoch   = decim.epoch;
+        t->startMs = nowMs;
+        t->bytes   = 0;
+    }
+    t->frames++;
+    t->bytes  += airLen;
+    t->lastMs  = nowMs;
+    if (profile.epoch != decim.epoch) {                             // Epoch started.
+        profile.epoch = decim.epoch;
+        profileEpoch(nowMs);
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Base profile - occurrence size.
+ * ------------------------------------------------
+ *
+ * @param  profileType * t Type (bytes = the occurrence just ended).
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-03:30am] New.
+ * @see    profileFrame().
+ */
+void profileSize(profileType * t) {
+    if (t->sizeAvg == 0) {
+        t->sizeMin = t->bytes;
+        t->sizeMax = t->bytes;
+        t->sizeAvg = t->bytes;
+        return;
+    }
+    t->sizeMin  = min(t->sizeMin, t->bytes);
+    t->sizeMax  = max(t->sizeMax, t->bytes);
+    t->sizeAvg += ((int32_t) t->bytes - (int32_t) t->sizeAvg) / 4;
+}
+
+/**
+ * ------------------------------------------------
+ *      Base profile - type rate.
+ * ------------------------------------------------
+ *
+ * A type seen once (e.g. 1005 every 10 s, early on) counts its bytes over the time since it was seen, so the
+ * forecast starts low & rises to the real rate when the second occurrence gives the period.
+ *
+ * @param  const profileType * t     Type.
+ * @param  uint32_t            nowMs Now (ms).
+ * @return uint32_t Air bytes/s.
+ * @since  3.1.1 [2026-10-18-03:30am] New.
+ * @see    profileEpoch().
+ */
+uint32_t profileRate(const profileType * t, uint32_t nowMs) {
+    uint32_t size   = (t->sizeAvg > 0) ? t->sizeAvg : t->bytes;
+    uint32_t period = (t->periodMs > 0) ? t->periodMs : max(nowMs - t->firstMs, decim.periodMs);
+    return (period > 0) ? size * 1000 / period : 0;
+}
+
+/**
+ * ------------------------------------------------
+ *      Base profile - epoch.
+ * ------------------------------------------------
+ *
+ * Drops types the base stopped sending (3 periods, or PROFILE_UNSEEN if seen once), then forecasts air bytes/s
+ * against the airtime model's capacity (1 / radioByteUs, times the links when split). Warns on the console when the
+ * base profile can't fit in DECIM_BUDGET_PCT of it, & again when it fits once more.
+ *
+ * @param  uint32_t nowMs Now (ms).
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-03:30am] New.
+ * @see    profileFrame().
+ */
+void profileEpoch(uint32_t nowMs) {
+
+    // -- Local vars. --
+    bool     fits;
+    bool     seed = false;
+    uint8_t  i    = 0;
+
+    while (i < profile.count) {                                     // Types no longer sent.
+        profileType * t = &profile.types[i];
+        if (nowMs - t->lastMs > ((t->periodMs > 0) ? 3 * t->periodMs + decim.periodMs : PROFILE_UNSEEN)) {
+            profile.types[i] = profile.types[--profile.count];
+            continue;
+        }
+        i++;
+    }
+    if (!profile.learned) {
+        if ((decim.epoch - profile.startEpoch < PROFILE_EPOCHS) || (decim.periodMs == 0)) {
+            return;
+        }
+        profile.learned = true;
+        seed            = true;
+    }
+    profile.forecast = 0;
+    for (i = 0; i < profile.count; i++) {
+        profile.forecast += profileRate(&profile.types[i], nowMs);
+    }
+    profile.capacity = (uint32_t) (1000000 / radioByteUs) * ((config.radio2 == RADIO2_SPLIT) ? RADIO_LINKS : 1);
+    fits = ((uint64_t) profile.forecast * 100 <= (uint64_t) profile.capacity * DECIM_BUDGET_PCT);
+    if (seed) {                                                     // Just learned.
+        profileSeed(nowMs);
+        Serial.printf("\nBase profile learned: %u types, epoch %lu ms, forecast %lu of %lu bytes/s (%lu%%).\n",
+                      (unsigned) profile.count, (unsigned long) decim.periodMs, (unsigned long) profile.forecast,
+                      (unsigned long) profile.capacity,
+                      (unsigned long) ((uint64_t) profile.forecast * 100 / profile.capacity));
+        profile.fits = true;                                        // Warn below if not.
+    }
+    if (fits != profile.fits) {
+        profile.fits = fits;
+        if (!fits) {
+            Serial.printf("\nWarning: base sends %lu bytes/s, radio carries %lu bytes/s - %s.\n",
+                          (unsigned long) profile.forecast, (unsigned long) profile.capacity,
+                          (decim.enabled ? "MSMs will be decimated" : "frames will queue & drop (decim off)"));
+        } else {
+            Serial.println("Base profile fits the radio link.");
+        }
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Base profile - seed decimation.
+ * ------------------------------------------------
+ *
+ * Sets the decimation averages from the learned profile & picks ratios that fit the budget at once, instead of one
+ * ratio step per epoch from a cold start.
+ *
+ * @param  uint32_t nowMs Now (ms).
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-03:30am] New.
+ * @see    profileEpoch().
+ * @see    decimEpochDone().
+ */
+void profileSeed(uint32_t nowMs) {
+
+    // -- Local vars. --
+    uint32_t perEpoch;
+    uint32_t load;
+    bool     raised = true;
+    int8_t   c;
+
+    memset(decim.avgBytes, 0, sizeof(decim.avgBytes));
+    decim.avgOther = 0;
+    for (uint8_t i = 0; i < profile.count; i++) {
+        perEpoch = profileRate(&profile.types[i], nowMs) * decim.periodMs / 1000;
+        if (profile.types[i].gnss >= 0) {
+            decim.avgBytes[profile.types[i].gnss] += perEpoch;
+        } else {
+            decim.avgOther += perEpoch;
+        }
+    }
+    decimBudget();
+    for (uint8_t i = 0; i < GNSS_NUM; i++) {
+        decim.ratio[i] = 1;
+    }
+    while (raised) {                                                // Lowest priority first until the plan fits.
+        load = 0;
+        for (uint8_t i = 0; i < GNSS_NUM; i++) {
+            load += decim.avgBytes[i] / decim.ratio[i];
+        }
+        raised = false;
+        for (int8_t p = GNSS_NUM - 1; (p >= 0) && (load > decim.budget); p--) {
+            c = DECIM_PRIORITY[p];
+            if ((decim.avgBytes[c] > 0) && (decim.ratio[c] < DECIM_MAX_RATIO)) {
+                decim.ratio[c]++;
+                raised = true;
+                break;
+            }
+        }
+    }
+    decimPhases();
+    if (config.radio2 == RADIO2_SPLIT) {
+        radioSplitPlan();
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Base profile - clear.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-03:30am] New.
+ * @see    checkSerialUSB().
+ */
+void profileClear() {
+    uint32_t relearns = profile.relearns;
+    memset(&profile, 0, sizeof(profile));
+    profile.relearns   = relearns + 1;
+    profile.startEpoch = decim.epoch;
+    profile.epoch      = decim.epoch;
+}
+
+/**
+ * ------------------------------------------------
+ *      Display base profile.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-03:30am] New.
+ * @see    checkSerialUSB().
+ */
+void showProfile() {
+
+    // -- Local vars. --
+    uint32_t nowMs = millis();
+
+    Serial.printf("\nBase profile: %s (%lu epochs), station %u, epoch %lu ms, relearns %lu.\n",
+                  (profile.learned ? "learned" : "learning"), (unsigned long) (decim.epoch - profile.startEpoch),
+                  (unsigned) profile.station, (unsigned long) decim.periodMs, (unsigned long) profile.relearns);
+    Serial.println("  Type  GNSS    Frames  Period ms  Bytes min/avg/max  Bytes/s");
+    for (uint8_t i = 0; i < profile.count; i++) {
+        const profileType * t = &profile.types[i];
+        Serial.printf("  %4u  %-5s  %7lu  %9lu  %5u/%5u/%5u  %7lu\n", (unsigned) t->type,
+                      ((t->gnss >= 0) ? GNSS_NAMES[t->gnss] : "-"), (unsigned long) t->frames,
+                      (unsigned long) t->periodMs, (unsigned) t->sizeMin, (unsigned) t->sizeAvg, (unsigned) t->sizeMax,
+                      (unsigned long) profileRate(t, nowMs));
+    }
+    if (profile.untracked > 0) {
+        Serial.printf("%lu frames of untracked types (more than %u types).\n", (unsigned long) profile.untracked,
+                      (unsigned) PROFILE_TYPES);
+    }
+    if (profile.learned) {
+        Serial.printf("Forecast %lu bytes/s, radio %lu bytes/s (%lu%%, budget %u%%) - %s.\n",
+                      (unsigned long) profile.forecast, (unsigned long) profile.capacity,
+                      (unsigned long) ((uint64_t) profile.forecast * 100 / profile.capacity),
+                      (unsigned) DECIM_BUDGET_PCT, (profile.fits ? "fits" : "does not fit"));
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Epoch forecast - MSM frame masks.
+ * ------------------------------------------------
+ *
+ * Counts satellites, cell mask bits & cells of a CRC-valid MSM frame for its constellation's epoch total.
+ *
+ * @param  int8_t   gnss     Constellation.
+ * @param  uint16_t msgType  MSM message type.
+ * @param  uint16_t frameLen Frame length (preamble to CRC).
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-04:00am] New.
+ * @see    checkFrameDone().
+ */
+void fcastFrame(int8_t gnss, uint16_t msgType, uint16_t frameLen) {
+
+    // -- Local vars. --
+    fcastMasks * m = &fcast.now[gnss];
+    bitReader    r;
+    uint8_t      sats;
+    uint8_t      sigs;
+    uint16_t     maskBits;
+    uint16_t     cells = 0;
+
+    if (frameLen < 3 + (MSM_HEADER_BITS + 7) / 8 + 3) {
+        return;
+    }
+    bitsInit(&r, (const uint8_t *) rtcmSentence, frameLen - 3, 24 + MSM_HEADER_BITS - 64 - 32);  // Satellite mask.
+    sats     = __builtin_popcountll(bitsGet64(&r, 64));
+    sigs     = __builtin_popcount(bitsGet(&r, 32));
+    maskBits = min((uint16_t) (sats * sigs), (uint16_t) 64);
+    for (uint16_t left = maskBits; left > 0; left -= min(left, (uint16_t) 32)) {
+        cells += __builtin_popcount(bitsGet(&r, min(left, (uint16_t) 32)));
+    }
+    m->type      = msgType;
+    m->frames   += 1;
+    m->sats     += sats;
+    m->maskBits += maskBits;
+    m->cells    += cells;
+}
+
+/**
+ * ------------------------------------------------
+ *      Epoch forecast - constellation air bytes.
+ * ------------------------------------------------
+ *
+ * Size of a constellation's MSMs from its masks: header & cell mask, then per satellite & per cell data for the
+ * MSM level (MSM_SAT_BITS, MSM_CELL_BITS), rounded up per frame, plus framing (RTCM3 or compact hop).
+ *
+ * @param  const fcastMasks * m Masks.
+ * @return uint32_t Air bytes, 0 if none.
+ * @since  3.1.1 [2026-10-18-04:00am] New.
+ * @since  3.1.1 [2026-10-18-05:00am] HOT_FN (IRAM under GR_IRAM), tables HOT_DATA.
+ * @since  3.1.1 [2026-10-18-06:30am] Off the hot path again (forecast only).
+ * @see    fcastStart().
+ */
+uint32_t fcastBytes(const fcastMasks * m) {
+
+    // -- Local vars. --
+    uint8_t  level = (m->type % 10) - 1;
+    uint32_t bits;
+    uint16_t frameLen;
+
+    if ((m->frames == 0) || (level > 6)) {
+        return 0;
+    }
+    bits     = (uint32_t) m->frames * MSM_HEADER_BITS + m->maskBits + (uint32_t) m->sats * MSM_SAT_BITS[level] +
+               (uint32_t) m->cells * MSM_CELL_BITS[level];
+    frameLen = (bits + 7 * m->frames) / 8 / m->frames + 6;
+    return (uint32_t) m->frames * ((config.hop == HOP_COMPACT) ? hopLen(frameLen) : frameLen);
+}
+
+/**
+ * ------------------------------------------------
+ *      Epoch forecast - first MSM of an epoch.
+ * ------------------------------------------------
+ *
+ * Forecast = each constellation's size from its last epoch masks (satellites & signals change slowly), the first
+ * MSM's own length, plus the non-MSM average; baseline = the decimation averages alone. Both are scored at the end
+ * of the epoch. Measurement only: a plan that dropped constellations on this forecast did no better than one on the
+ * averages at equal bytes delivered (tools/epoch_forecast.py), so decimation stays on the averages.
+ *
+ * @param  int8_t   gnss     First MSM's constellation.
+ * @param  uint16_t frameLen First MSM's frame length.
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-04:00am] New (fcastPlan()).
+ * @since  3.1.1 [2026-10-18-05:00am] HOT_FN (IRAM under GR_IRAM).
+ * @since  3.1.1 [2026-10-18-06:30am] Forecast only, no plan (fcast.skip); from checkFrameDone(), not HOT_FN.
+ * @see    checkFrameDone().
+ */
+void fcastStart(int8_t gnss, uint16_t frameLen) {
+
+    // -- Local vars. --
+    uint32_t bytes[GNSS_NUM];
+    uint32_t known = 0;
+
+    fcast.open     = true;
+    fcast.baseline = decim.avgOther;
+    fcast.forecast = decim.avgOther;
+    for (uint8_t i = 0; i < GNSS_NUM; i++) {
+        bytes[i]        = fcastBytes(&fcast.last[i]);
+        known          += bytes[i];
+        fcast.baseline += decim.avgBytes[i];
+    }
+    bytes[gnss] = max(bytes[gnss],
+                      (uint32_t) ((config.hop == HOP_COMPACT) ? hopLen(frameLen) : frameLen));
+    for (uint8_t i = 0; i < GNSS_NUM; i++) {
+        fcast.forecast += (known == 0) ? decim.avgBytes[i] : bytes[i];   // No masks yet (start) - averages.
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Epoch forecast - epoch done.
+ * ------------------------------------------------
+ *
+ * Scores the forecast made at the epoch's first MSM against the bytes that came in (demand, sent or not), & keeps
+ * this epoch's masks for the next forecast. Called before decimEpochDone() folds & clears the epoch bytes.
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-04:00am] New.
+ * @see    checkFrameDone().
+ * @see    rtcmDecide().
+ */
+void fcastEpochDone() {
+
+    // -- Local vars. --
+    uint32_t actual = decim.otherBytes;
+    int32_t  err;
+
+    for (uint8_t i = 0; i < GNSS_NUM; i++) {
+        actual += decim.epochBytes[i];
+    }
+    if (fcast.open && (selfTest.mode == ST_OFF)) {
+        err               = (int32_t) actual - (int32_t) fcast.forecast;
+        fcast.epochs++;
+        fcast.actual     += actual;
+        fcast.errSum     += err;
+        fcast.errAbs     += abs(err);
+        fcast.errMax      = max(fcast.errMax, (uint32_t) abs(err));
+        fcast.baseErrAbs += abs((int32_t) actual - (int32_t) fcast.baseline);
+    }
+    memcpy(fcast.last, fcast.now, sizeof(fcast.last));
+    memset(fcast.now, 0, sizeof(fcast.now));
+    fcast.open = false;
+}
+
+/**
+ * ------------------------------------------------
+ *      Epoch forecast - clear stats.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-04:00am] New.
+ * @see    checkSerialUSB().
+ */
+void fcastClear() {
+    fcast.epochs     = 0;
+    fcast.errAbs     = 0;
+    fcast.errSum     = 0;
+    fcast.errMax     = 0;
+    fcast.baseErrAbs = 0;
+    fcast.actual     = 0;
+}
+
+/**
+ * ------------------------------------------------
+ *      Display epoch forecast.
+ * ------------------------------------------------
+ *
+ * Masks vs averages on this base's own stream - the on-device check of tools/epoch_forecast.py.
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-04:00am] New.
+ * @since  3.1.1 [2026-10-18-06:30am] No plan line (plan removed).
+ * @see    checkSerialUSB().
+ */
+void showForecast() {
+
+    // -- Local vars. --
+    uint32_t n = max(fcast.epochs, (uint32_t) 1);
+
+    Serial.printf("\nEpoch forecast: %lu epochs, %lu bytes/epoch actual.\n", (unsigned long) fcast.epochs,
+                  (unsigned long) (fcast.actual / n));
+    Serial.printf("Masks: error %lu bytes/epoch (%lu%%), bias %+ld, max %lu. Averages (EMA): error %lu bytes/epoch.\n",
+                  (unsigned long) (fcast.errAbs / n),
+                  (unsigned long) ((fcast.actual > 0) ? fcast.errAbs * 100 / fcast.actual : 0),
+                  (long) (fcast.errSum / (int64_t) n), (unsigned long) fcast.errMax,
+                  (unsigned long) (fcast.baseErrAbs / n));
+    Serial.println("  GNSS   Type  Sats  Cells  Forecast B");
+    for (uint8_t i = 0; i < GNSS_NUM; i++) {
+        if (fcast.last[i].frames == 0) {
+            continue;
+        }
+        Serial.printf("  %-6s %4u  %4u  %5u  %10lu\n", GNSS_NAMES[i], (unsigned) fcast.last[i].type,
+                      (unsigned) fcast.last[i].sats, (unsigned) fcast.last[i].cells,
+                      (unsigned long) fcastBytes(&fcast.last[i]));
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      ZED speed - candidate.
+ * ------------------------------------------------
+ *
+ * @param  uint8_t idx Candidate: 0 = config.serial0Speed (last good), then BAUD_RATES without it.
+ * @return uint32_t Speed (bps).
+ * @since  3.1.1 [2026-10-18-04:30am] New.
+ * @see    checkBaud().
+ */
+uint32_t baudCandidate(uint8_t idx) {
+    if (idx == 0) {
+        return config.serial0Speed;
+    }
+    for (uint8_t i = 0; i < BAUD_RATES_NUM; i++) {
+        if ((BAUD_RATES[i] != config.serial0Speed) && (--idx == 0)) {
+            return BAUD_RATES[i];
+        }
+    }
+    return 0;
+}
+
+/**
+ * ------------------------------------------------
+ *      ZED speed - try a candidate.
+ * ------------------------------------------------
+ *
+ * @param  uint8_t idx Candidate.
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-04:30am] New.
+ * @see    checkBaud().
+ */
+void baudTry(uint8_t idx) {
+    if (idx != 0) {                                                 // Moved off the last good speed - hold from here.
+        baud.provisional = false;
+    }
+    baud.idx  = idx;
+    baud.rate = baudCandidate(idx);
+    Serial0.updateBaudRate(baud.rate);
+    rxTs.byteUs = 10 * 1000000 / (int64_t) baud.rate;
+    while (Serial0.available() > 0) {                               // Bytes at the last speed.
+        Serial0.read();
+        rxTs.readIdx++;
+    }
+    rtcmResync       = true;
+    baud.windowStart = millis();
+    baud.bytesAt     = flightRec.now.bytesIn;
+    baud.ok          = 0;
+    baud.bad         = 0;
+}
+
+/**
+ * ------------------------------------------------
+ *      ZED speed - scan.
+ * ------------------------------------------------
+ *
+ * Starts with the last good speed, so a ZED that did not change locks on its first frame. Provisional (boot,
+ * watchdog re-init): frames at the last good speed are relayed meanwhile, so the first correction after power-on
+ * isn't lost. Relaying is held once the scan moves to other candidates (a wrong speed turns RTCM3 into garbage
+ * that can still cut through to the radio), & from the start when the last good speed is already in doubt
+ * (garbage on a locked line, "baud scan").
+ *
+ * @param  bool provisional Relay at the last good speed until the scan moves on.
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-04:30am] New.
+ * @since  3.1.1 [2026-10-18-05:00am] Provisional relay at the last good speed.
+ * @see    checkBaud().
+ * @see    checkWatchdog().
+ */
+void baudScan(bool provisional) {
+    if (role != ROLE_RELAY) {
+        return;
+    }
+    baud.stage       = BAUD_SCAN;
+    baud.provisional = provisional;
+    baud.scanStart   = millis();
+    baud.scans++;
+    memset(baud.score, 0, sizeof(baud.score));
+    baudTry(0);
+}
+
+/**
+ * ------------------------------------------------
+ *      ZED speed - frame.
+ * ------------------------------------------------
+ *
+ * @param  bool crcOk CRC-24Q passed.
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-04:30am] New.
+ * @see    checkFrameDone().
+ */
+void baudFrame(bool crcOk) {
+    if (!crcOk) {
+        baud.bad++;
+        return;
+    }
+    baud.ok++;
+    baud.lastValid    = millis();
+    baud.bytesAtValid = flightRec.now.bytesIn;
+}
+
+/**
+ * ------------------------------------------------
+ *      ZED speed - check (from loop()).
+ * ------------------------------------------------
+ *
+ * Scan: each candidate gets BAUD_WINDOW_MS of input (the window waits while the line is quiet, so a ZED without a
+ * fix doesn't use up candidates). BAUD_MIN_FRAMES CRC-valid frames, more than the failed ones, lock at once - at a
+ * wrong speed a valid CRC-24Q is ~2^-24 per frame, so the first to get there is the winner. Otherwise the best
+ * CRC-valid yield of a full pass wins; none - scan again. The speed found is set in config (cfg commit keeps it).
+ * Locked: bytes still arriving with no valid frame for BAUD_GARBAGE_MS (ZED speed changed) - scan again.
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-04:30am] New.
+ * @see    baudScan().
+ */
+void checkBaud() {
+
+    // -- Local vars. --
+    uint32_t nowMs = millis();
+    uint8_t  best  = 0;
+
+    if (!config.autobaud) {
+        baud.stage = BAUD_LOCKED;
+        return;
+    }
+    if (baud.stage == BAUD_LOCKED) {
+        if ((nowMs - baud.lastValid > BAUD_GARBAGE_MS) && (flightRec.now.bytesIn - baud.bytesAtValid > BAUD_MIN_BYTES)) {
+            Serial.printf("\nSerial0: no valid RTCM3 at %lu bps for %lu ms - scanning.\n", (unsigned long) baud.rate,
+                          (unsigned long) BAUD_GARBAGE_MS);
+            baudScan(false);
+        }
+        return;
+    }
+    if ((baud.ok >= ((baud.idx == 0) ? 1 : BAUD_MIN_FRAMES)) && (baud.ok > baud.bad)) {
+        baudLock();
+        return;
+    }
+    if (flightRec.now.bytesIn - baud.bytesAt < BAUD_MIN_BYTES) {    // Quiet line - wait for input.
+        baud.windowStart = nowMs;
+        return;
+    }
+    if (nowMs - baud.windowStart < BAUD_WINDOW_MS) {
+        return;
+    }
+    baud.score[baud.idx] = baud.ok;
+    if (baudCandidate(baud.idx + 1) != 0) {
+        baudTry(baud.idx + 1);
+        return;
+    }
+    for (uint8_t i = 1; baudCandidate(i) != 0; i++) {               // Full pass - best yield.
+        if (baud.score[i] > baud.score[best]) {
+            best = i;
+        }
+    }
+    if (baud.score[best] == 0) {
+        Serial.println("\nSerial0: no valid RTCM3 at any speed - scanning again.");
+        memset(baud.score, 0, sizeof(baud.score));
+        baudTry(0);
+        return;
+    }
+    baudTry(best);
+    baudLock();
+}
+
+/**
+ * ------------------------------------------------
+ *      ZED speed - lock.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-04:30am] New.
+ * @see    checkBaud().
+ */
+void baudLock() {
+    baud.score[baud.idx] = max(baud.score[baud.idx], baud.ok);
+    baud.stage           = BAUD_LOCKED;
+    baud.locks++;
+    baud.lockMs          = millis() - baud.scanStart;
+    baud.lastValid       = millis();
+    baud.bytesAtValid    = flightRec.now.bytesIn;
+    if (baud.rate != config.serial0Speed) {
+        baud.changes++;
+        Serial.printf("\nSerial0: ZED RTCM3 at %lu bps (cfg serial0 was %lu, cfg commit to keep), %lu ms.\n",
+                      (unsigned long) baud.rate, (unsigned long) config.serial0Speed, (unsigned long) baud.lockMs);
+        config.serial0Speed = baud.rate;
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Display ZED speed detection.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-04:30am] New.
+ * @see    checkSerialUSB().
+ */
+void showBaud() {
+
+    // -- Local vars. --
+    const char * state = (baud.stage == BAUD_LOCKED) ? "locked"
+                       : (baud.provisional && (baud.idx == 0)) ? "scanning (relaying at last good speed)"
+                       : "scanning (relay held)";
+
+    Serial.printf("\nSerial0 (ZED) %lu bps, %s, autobaud %s.\n", (unsigned long) baud.rate, state,
+                  (config.autobaud ? "on" : "off"));
+    Serial.printf("Scans %lu, locks %lu (%lu at another speed), last scan to lock %lu ms.\n", (unsigned long) baud.scans,
+                  (unsigned long) baud.locks, (unsigned long) baud.changes, (unsigned long) baud.lockMs);
+    Serial.print("Last pass, valid frames:");
+    for (uint8_t i = 0; baudCandidate(i) != 0; i++) {
+        Serial.printf(" %lu=%u", (unsigned long) baudCandidate(i), (unsigned) baud.score[i]);
+    }
+    Serial.println();
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit reader - start.
+ * ------------------------------------------------
+ *
+ * Zero allocation. Fields are read in order; the window is refilled a byte at a time up to 64 bits, so most reads are
+ * a shift & a mask. Bits past the end read as 0 (overrun flagged when BITS_CHECKED).
+ *
+ * @param  bitReader *     r      Reader.
+ * @param  const uint8_t * buffer Buffer.
+ * @param  uint32_t        bytes  Buffer length.
+ * @param  uint32_t        pos    First bit.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-09:00pm] New. Replaces getBits().
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    bitsGet().
+ */
+void HOT_FN bitsInit(bitReader * r, const uint8_t * buffer, uint32_t bytes, uint32_t pos) {
+    r->buf     = buffer;
+    r->bytes   = bytes;
+    r->next    = pos >> 3;
+    r->window  = 0;
+    r->count   = 0;
+    r->overrun = (r->next > bytes);
+    bitsRefill(r);
+    pos &= 7;
+    if (pos > r->count) {
+        pos = r->count;
+    }
+    r->window <<= pos;                                              // Drop leading bits of the first byte.
+    r->count   -= pos;
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit reader - refill window.
+ * ------------------------------------------------
+ *
+ * @param  bitReader * r Reader.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-09:00pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ */
+void HOT_FN bitsRefill(bitReader * r) {
+    while ((r->count <= 56) && (r->next < r->bytes)) {
+        r->window |= (uint64_t) r->buf[r->next++] << (56 - r->count);
+        r->count  += 8;
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit reader - unsigned field.
+ * ------------------------------------------------
+ *
+ * @param  bitReader * r   Reader.
+ * @param  uint8_t     len Bits (1 to 32).
+ * @return uint32_t Value.
+ * @since  3.1.0 [2026-10-17-09:00pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ */
+uint32_t HOT_FN bitsGet(bitReader * r, uint8_t len) {
+
+    // -- Local vars. --
+    uint32_t value;
+
+    if (BITS_CHECKED && ((len == 0) || (len > 32))) {
+        r->overrun = true;
+        return 0;
+    }
+    if (r->count < len) {
+        bitsRefill(r);
+        if (BITS_CHECKED && (r->count < len)) {
+            r->overrun = true;
+        }
+    }
+    value      = (uint32_t) (r->window >> (64 - len));
+    r->window <<= len;
+    r->count   = (r->count > len) ? r->count - len : 0;
+    return value;
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit reader - signed (two's complement) field.
+ * ------------------------------------------------
+ *
+ * @param  bitReader * r   Reader.
+ * @param  uint8_t     len Bits (1 to 32).
+ * @return int32_t Value.
+ * @since  3.1.0 [2026-10-17-09:00pm] New.
+ */
+int32_t bitsGetSigned(bitReader * r, uint8_t len) {
+    return ((int32_t) (bitsGet(r, len) << (32 - len))) >> (32 - len);
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit reader - wide field (e.g. 1005 38 bit ECEF).
+ * ------------------------------------------------
+ *
+ * @param  bitReader * r   Reader.
+ * @param  uint8_t     len Bits (33 to 64).
+ * @return uint64_t Value.
+ * @since  3.1.0 [2026-10-17-09:00pm] New.
+ */
+uint64_t bitsGet64(bitReader * r, uint8_t len) {
+    uint64_t high = bitsGet(r, len - 32);
+    return (high << 32) | bitsGet(r, 32);
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit reader - signed (two's complement) wide field.
+ * ------------------------------------------------
+ *
+ * @param  bitReader * r   Reader.
+ * @param  uint8_t     len Bits (33 to 64).
+ * @return int64_t Value.
+ * @since  3.1.0 [2026-10-17-09:00pm] New.
+ */
+int64_t bitsGetSigned64(bitReader * r, uint8_t len) {
+    return ((int64_t) (bitsGet64(r, len) << (64 - len))) >> (64 - len);
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit reader - skip.
+ * ------------------------------------------------
+ *
+ * @param  bitReader * r   Reader.
+ * @param  uint32_t    len Bits to skip.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-09:00pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ */
+void HOT_FN bitsSkip(bitReader * r, uint32_t len) {
+    if (len < r->count) {                                           // Within the window (len < 64).
+        r->window <<= len;
+        r->count   -= len;
+        return;
+    }
+    bitsInit(r, r->buf, r->bytes, bitsTell(r) + len);
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit reader - position.
+ * ------------------------------------------------
+ *
+ * @param  bitReader * r Reader.
+ * @return uint32_t Bit position of the next read.
+ * @since  3.1.0 [2026-10-17-09:00pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ */
+uint32_t HOT_FN bitsTell(const bitReader * r) {
+    return r->next * 8 - r->count;
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit writer - start.
+ * ------------------------------------------------
+ *
+ * Writes whole bytes from the start of the buffer.
+ *
+ * @param  bitWriter * w      Writer.
+ * @param  uint8_t *   buffer Buffer.
+ * @param  uint32_t    bytes  Buffer length.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-09:00pm] New. Replaces setBits().
+ * @see    buildTelemetry().
+ */
+void bitsInitWriter(bitWriter * w, uint8_t * buffer, uint32_t bytes) {
+    w->buf     = buffer;
+    w->bytes   = bytes;
+    w->next    = 0;
+    w->window  = 0;
+    w->count   = 0;
+    w->overrun = false;
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit writer - put.
+ * ------------------------------------------------
+ *
+ * @param  bitWriter * w     Writer.
+ * @param  uint8_t     len   Bits (1 to 32).
+ * @param  uint32_t    value Value (two's complement for signed fields).
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-09:00pm] New. Replaces setBits().
+ */
+void bitsPut(bitWriter * w, uint8_t len, uint32_t value) {
+    if (BITS_CHECKED && ((len == 0) || (len > 32))) {
+        w->overrun = true;
+        return;
+    }
+    w->window |= ((uint64_t) value << (64 - len)) >> w->count;    // count < 8 here, so count + len <= 40.
+    w->count  += len;
+    while (w->count >= 8) {
+        if (w->next < w->bytes) {
+            w->buf[w->next++] = (uint8_t) (w->window >> 56);
+        } else if (BITS_CHECKED) {
+            w->overrun = true;
+        }
+        w->window <<= 8;
+        w->count   -= 8;
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit writer - flush.
+ * ------------------------------------------------
+ *
+ * Stores the last partial byte (zero padded).
+ *
+ * @param  bitWriter * w Writer.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-09:00pm] New.
+ */
+void bitsFlush(bitWriter * w) {
+    if (w->count > 0) {
+        bitsPut(w, 8 - w->count, 0);
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit fields - reference read (bit at a time).
+ * ------------------------------------------------
+ *
+ * Independent slow implementation, the oracle for bitsTest().
+ *
+ * @param  const uint8_t * buffer Buffer.
+ * @param  uint32_t        pos    First bit.
+ * @param  uint8_t         len    Bits (<= 32).
+ * @return uint32_t Value.
+ * @since  3.1.0 [2026-10-17-09:00pm] New. Was getBits().
+ * @see    bitsTest().
+ */
+uint32_t bitsReference(const uint8_t * buffer, uint32_t pos, uint8_t len) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < len; i++, pos++) {
+        value = (value << 1) | ((buffer[pos >> 3] >> (7 - (pos & 7))) & 1);
+    }
+    return value;
+}
+
+/**
+ * ------------------------------------------------
+ *      Bit fields - self test & per field timing.
+ * ------------------------------------------------
+ *
+ * Reference encodings (incl. bytes >= 0x80 that the old signed char extraction got wrong), a random write/read round
+ * trip checked against bitsReference(), bounds checks (debug builds), then CPU cycles per field for the reader vs
+ * the reference.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-09:00pm] New.
+ * @see    checkSerialUSB().
+ */
+void bitsTest() {
+
+    // -- Local vars. --
+    static const uint8_t REF[] = {0xd3, 0x00, 0x13, 0x3e, 0xd7, 0xd3, 0xff, 0xfe, 0x80, 0x01};
+    static const uint8_t WIDTHS[] = {12, 30, 22, 32};               // Bench: type, MSM epoch, signed, full word.
+           uint8_t       buf[64];
+           uint32_t      values[40];
+           uint8_t       widths[40];
+           uint32_t      seed = 12345;
+           uint32_t      fails = 0;
+           uint32_t      cycles;
+           uint32_t      sink = 0;
+           bitReader     r;
+           bitWriter     w;
+
+    // - Reference encodings. -
+    bitsInit(&r, REF, sizeof(REF), 8);
+    fails += (bitsGet(&r, 6) != 0) + (bitsGet(&r, 10) != 19) + (bitsGet(&r, 12) != 1005) + (bitsGet(&r, 12) != 2003);
+    fails += (bitsGet(&r, 12) != 0xfff) + (bitsGetSigned(&r, 12) != -384) + (bitsGetSigned(&r, 8) != 1);
+    bitsInit(&r, REF, sizeof(REF), 48);
+    fails += (bitsGetSigned(&r, 16) != -2) + (bitsGet(&r, 16) != 0x8001);
+    fails += (rtcm3GetMessageType((const char *) REF) != 1005);
+    buf[0] = RTCM_PREAMBLE; buf[3] = 0xff; buf[4] = 0xf0;           // Type 4095 - all high bits set.
+    fails += (rtcm3GetMessageType((const char *) buf) != 4095);
+    bitsInit(&r, REF, sizeof(REF), 0);
+    fails += (bitsGetSigned64(&r, 38) != -0xb3ffb304bLL);           // 38 bit signed, as 1005 ECEF.
+    bitsInit(&r, REF, sizeof(REF), 0);
+    fails += (bitsGet64(&r, 40) != 0xd300133ed7ULL);
+
+    // - Random round trip. -
+    for (uint8_t pass = 0; pass < 20; pass++) {
+        uint32_t pos = 0;
+        bitsInitWriter(&w, buf, sizeof(buf));
+        for (uint8_t i = 0; i < 40; i++) {
+            seed       = seed * 1103515245 + 12345;
+            widths[i]  = 1 + (seed >> 16) % 12;
+            values[i]  = (seed * 2654435761UL) & ((1UL << widths[i]) - 1);
+            bitsPut(&w, widths[i], values[i]);
+        }
+        bitsFlush(&w);
+        bitsInit(&r, buf, sizeof(buf), 0);
+        for (uint8_t i = 0; i < 40; i++) {
+            fails += (bitsReference(buf, pos, widths[i]) != values[i]) + (bitsGet(&r, widths[i]) != values[i]);
+            pos   += widths[i];
+        }
+    }
+
+    // - Bounds. -
+    if (BITS_CHECKED) {
+        bitsInit(&r, REF, 2, 0);
+        bitsGet(&r, 16);
+        fails += r.overrun;
+        bitsGet(&r, 1);
+        fails += !r.overrun;
+    }
+    Serial.printf("\nBit fields: %s (%lu failures).\n", (fails == 0 ? "OK" : "FAILED"), (unsigned long) fails);
+
+    // - Per field timing (CPU cycles, 100 fields). -
+    Serial.println("  Field   bitsGet  reference");
+    for (size_t i = 0; i < sizeof(WIDTHS); i++) {
+        uint32_t fast;
+        cycles = esp_cpu_get_cycle_count();
+        bitsInit(&r, buf, sizeof(buf), 0);
+        for (uint8_t n = 0; n < 100; n++) {
+            if (bitsTell(&r) + WIDTHS[i] > sizeof(buf) * 8) {
+                bitsInit(&r, buf, sizeof(buf), 0);
+            }
+            sink += bitsGet(&r, WIDTHS[i]);
+        }
+        fast   = esp_cpu_get_cycle_count() - cycles;
+        cycles = esp_cpu_get_cycle_count();
+        for (uint32_t n = 0, pos = 0; n < 100; n++) {
+            if (pos + WIDTHS[i] > sizeof(buf) * 8) {
+                pos = 0;
+            }
+            sink += bitsReference(buf, pos, WIDTHS[i]);
+            pos  += WIDTHS[i];
+        }
+        cycles = esp_cpu_get_cycle_count() - cycles;
+        Serial.printf("  %2u bit  %5lu.%lu  %7lu.%lu  cycles/field\n", (unsigned) WIDTHS[i],
+                      (unsigned long) (fast / 100), (unsigned long) (fast % 100 / 10),
+                      (unsigned long) (cycles / 100), (unsigned long) (cycles % 100 / 10));
+    }
+    if (sink == 0x5a5a5a5a) {                                       // Keep the loops.
+        Serial.println();
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Bench: build sample stream.
+ * ------------------------------------------------
+ *
+ * 1005, 1230 & MSM7 for GPS, GLONASS, Galileo & BeiDou (10/8/9/11 satellites, 2 signals) with valid headers, masks &
+ * CRC-24Q; satellite & signal data are pseudo-random. About 1.1 KB - one 1 Hz epoch of a typical base.
+ *
+ * @param  uint8_t *  buf  Stream buffer (BENCH_STREAM).
+ * @param  uint16_t * lens Frame lengths (BENCH_FRAMES).
+ * @return size_t Stream bytes.
+ * @since  3.1.1 [2026-10-18-12:30am] New.
+ * @see    benchRun().
+ */
+size_t benchSamples(uint8_t * buf, uint16_t * lens) {
+
+    // -- Local vars. --
+    static const uint16_t TYPES[BENCH_FRAMES] = {1005, 1230, 1077, 1087, 1097, 1127};
+    static const uint8_t  SATS[BENCH_FRAMES]  = {0, 0, 10, 8, 9, 11};
+           uint32_t       seed = 1;
+           size_t         pos  = 0;
+           uint32_t       crc;
+           bitWriter      w;
+
+    for (uint8_t f = 0; f < BENCH_FRAMES; f++) {
+        uint16_t payloadLen = (TYPES[f] == 1005) ? 19 : (TYPES[f] == 1230) ? 6 :
+                              (169 + 2 * SATS[f] + 36 * SATS[f] + 2 * SATS[f] * 80 + 7) / 8;  // MSM7 bits.
+        bitsInitWriter(&w, &buf[pos], BENCH_STREAM - pos);
+        bitsPut(&w,  8, RTCM_PREAMBLE);
+        bitsPut(&w,  6, 0);
+        bitsPut(&w, 10, payloadLen);
+        bitsPut(&w, 12, TYPES[f]);
+        bitsPut(&w, 12, 2003);                                      // Station.
+        if (SATS[f] > 0) {
+            bitsPut(&w, 30, 345600000 + f);                         // Epoch time.
+            bitsPut(&w,  1, (f < BENCH_FRAMES - 1) ? 1 : 0);        // Multiple message bit.
+            bitsPut(&w, 18, 0);                                     // IODS ... smoothing interval.
+            bitsPut(&w, 32, (1UL << SATS[f]) - 1);                  // Satellite mask (64).
+            bitsPut(&w, 32, 0);
+            bitsPut(&w, 32, 0x40010000);                            // Signal mask, 2 signals.
+            bitsPut(&w,  2 * SATS[f] > 32 ? 32 : 2 * SATS[f], 0xffffffff);     // Cell mask.
+            if (2 * SATS[f] > 32) {
+                bitsPut(&w, 2 * SATS[f] - 32, 0xffffffff);
+            }
+        }
+        bitsFlush(&w);
+        for (size_t i = pos + ((SATS[f] > 0) ? 3 + (169 + 2 * SATS[f] + 7) / 8 : 6); i < pos + 3 + payloadLen; i++) {
+            seed   = seed * 1103515245 + 12345;                     // Satellite & signal data.
+            buf[i] = (uint8_t) (seed >> 16);
+        }
+        if (TYPES[f] == 1230) {                                     // 1230: station, bias flag, reserved, no masks.
+            buf[pos + 6] = 0x00;
+            buf[pos + 7] = 0x00;
+            buf[pos + 8] = 0x00;
+        }
+        crc = crc24q(&buf[pos], 3 + payloadLen);
+        buf[pos + 3 + payloadLen]     = (uint8_t) (crc >> 16);
+        buf[pos + 3 + payloadLen + 1] = (uint8_t) (crc >> 8);
+        buf[pos + 3 + payloadLen + 2] = (uint8_t) crc;
+        lens[f] = payloadLen + 6;
+        pos    += lens[f];
+    }
+    return pos;
+}
+
+/**
+ * ------------------------------------------------
+ *      Bench: one kernel pass.
+ * ------------------------------------------------
+ *
+ * Pure kernel bodies over the sample stream: no Serial, no relay state (sched saves & restores what it touches), so
+ * they also build off target.
+ *
+ * @param  benchKernelId   k      Kernel.
+ * @param  const uint8_t * stream Sample stream.
+ * @param  size_t          len    Stream bytes.
+ * @param  const uint16_t* lens   Frame lengths.
+ * @return uint32_t Result sink (keeps the work).
+ * @since  3.1.1 [2026-10-18-12:30am] New.
+ * @see    benchRun().
+ */
+uint32_t benchKernel(benchKernelId k, const uint8_t * stream, size_t len, const uint16_t * lens) {
+
+    // -- Local vars. --
+    static uint8_t    frame[RTCM_MAX_FRAME];
+           uint32_t   sink = 0;
+           size_t     pos  = 0;
+           rtcmParser p    = {frame, 0, 0, 0};
+           bitReader  r;
+
+    switch (k) {
+        case BENCH_FRAMING:
+            for (size_t i = 0; i < len; i++) {
+                sink += rtcmParse(&p, stream[i]);
+            }
+            break;
+        case BENCH_CRC24Q:
+            for (uint8_t f = 0; f < BENCH_FRAMES; f++) {
+                sink += crc24q(&stream[pos], lens[f] - 3);
+                pos  += lens[f];
+            }
+            break;
+        case BENCH_BITS:
+            for (uint8_t f = 0; f < BENCH_FRAMES; f++) {
+                uint64_t sats;
+                uint8_t  nSat;
+                bitsInit(&r, &stream[pos], lens[f], 24);
+                sink += bitsGet(&r, 12) + bitsGet(&r, 12);          // Type, station.
+                if (lens[f] > 40) {                                 // MSM7.
+                    sink += bitsGet(&r, 30) + bitsGet(&r, 1);       // Epoch, multiple message bit.
+                    bitsSkip(&r, 18);
+                    sats  = bitsGet64(&r, 64);
+                    nSat  = __builtin_popcountll(sats);
+                    sink += bitsGet(&r, 32);                        // Signal mask.
+                    bitsSkip(&r, 2 * nSat);                         // Cell mask.
+                    for (uint8_t s = 0; s < nSat; s++) {            // Rough range ms, extended info.
+                        sink += bitsGet(&r, 8) + bitsGet(&r, 4);
+                    }
+                    for (uint8_t s = 0; s < nSat; s++) {            // Rough range mod 1 ms, phase range rate.
+                        sink += bitsGet(&r, 10) + bitsGetSigned(&r, 14);
+                    }
+                    for (uint8_t c = 0; c < 2 * nSat; c++) {        // Cells: pseudorange, phase, lock, half, CNR, rate.
+                        sink += bitsGetSigned(&r, 20) + bitsGetSigned(&r, 24) + bitsGet(&r, 10) + bitsGet(&r, 1) +
+                                bitsGet(&r, 10) + bitsGetSigned(&r, 15);
+                    }
+                }
+                pos += lens[f];
+            }
+            break;
+        case BENCH_HOP:
+            for (uint8_t f = 0; f < BENCH_FRAMES; f++) {
+                uint16_t payloadLen = lens[f] - 6;
+                uint8_t  header[2]  = {(uint8_t) (payloadLen | ((payloadLen < 0x80) ? 0 : 0x80)), (uint8_t) (payloadLen >> 7)};
+                uint16_t crc        = crc16(0xffff, header, (payloadLen < 0x80) ? 1 : 2);
+                sink += crc16(crc, &stream[pos + 3], payloadLen) + hopLen(lens[f]);
+                pos  += lens[f];
+            }
+            break;
+        case BENCH_SCHED: {
+            static decimState savedDecim;
+            static hopState   savedHop;
+                   uint8_t    savedLink[GNSS_NUM];
+            savedDecim = decim;
+            savedHop   = hop;
+            memcpy(savedLink, gnssLink, sizeof(gnssLink));
+            for (uint8_t f = 2; f < BENCH_FRAMES; f++) {            // Epoch demand from the sample MSMs.
+                decim.epochBytes[rtcmMsmGnss(1077 + 10 * (f - 2) + ((f == 5) ? 20 : 0))] = lens[f];
+            }
+            decim.periodMs = 1000;
+            decimEpochDone();
+            sink += decim.budget + decim.ratio[0];
+            decim = savedDecim;
+            hop   = savedHop;
+            memcpy(gnssLink, savedLink, sizeof(gnssLink));
+            break;
+        }
+        default:
+            break;
+    }
+    return sink;
+}
+
+/**
+ * ------------------------------------------------
+ *      Bench: run & report.
+ * ------------------------------------------------
+ *
+ * Cycle counter (esp_cpu_get_cycle_count) per kernel: cold = first pass after invalidating the flash cache (code &
+ * tables refetched from flash), warm = mean of BENCH_WARM passes after it. Per frame & per byte of the sample epoch;
+ * sched is per epoch plan. By default the bench starts in an inter-epoch gap & the relay drains Serial0 between
+ * kernels (no input lost); "bench pause" skips both - cleaner numbers, but input can back up.
+ *
+ * @param  bool pause Relay paused for the whole bench.
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-12:30am] New.
+ * @since  3.1.1 [2026-10-18-06:30am] Debug vs production comparison (benchCompare()).
+ * @see    checkSerialUSB().
+ */
+void benchRun(bool pause) {
+
+    // -- Local vars. --
+    static uint8_t  stream[BENCH_STREAM];
+           uint16_t lens[BENCH_FRAMES];
+           size_t   len;
+           uint32_t cold[BENCH_KERNELS];
+           uint32_t warm[BENCH_KERNELS];
+           uint32_t cycles;
+           uint32_t sink     = 0;
+           uint32_t serviced = 0;
+           uint32_t start    = millis();
+
+    len = benchSamples(stream, lens);
+    while (!pause && !inEpochGap(50000) && (millis() - start < 2000)) {    // Start in a gap (max 2 s wait).
+        checkRTCMtoRadio();
+        checkFrameDone();
+    }
+    for (uint8_t k = 0; k < BENCH_KERNELS; k++) {
+        cache_hal_invalidate_addr(SOC_IROM_LOW, SOC_IROM_HIGH - SOC_IROM_LOW);     // Cold: code & tables from flash.
+        cycles  = esp_cpu_get_cycle_count();
+        sink   += benchKernel((benchKernelId) k, stream, len, lens);
+        cold[k] = esp_cpu_get_cycle_count() - cycles;
+        cycles  = esp_cpu_get_cycle_count();
+        for (uint8_t n = 0; n < BENCH_WARM; n++) {
+            sink += benchKernel((benchKernelId) k, stream, len, lens);
+        }
+        warm[k] = (esp_cpu_get_cycle_count() - cycles) / BENCH_WARM;
+        while (!pause && (Serial0.available() > 0)) {               // Relay catches up.
+            checkRTCMtoRadio();
+            checkFrameDone();
+            serviced++;
+        }
+    }
+    Serial.printf("\nBench (CPU cycles @ %lu MHz, %u frames, %lu bytes, relay %s, %lu bytes relayed meanwhile):\n",
+                  (unsigned long) getCpuFrequencyMhz(), (unsigned) BENCH_FRAMES, (unsigned long) len,
+                  (pause ? "paused" : "running"), (unsigned long) serviced);
+    Serial.println("  Kernel    Cold/frame  Warm/frame  Warm/byte");
+    for (uint8_t k = 0; k < BENCH_KERNELS; k++) {
+        uint8_t per = (k == BENCH_SCHED) ? 1 : BENCH_FRAMES;
+        Serial.printf("  %-8s  %10lu  %10lu  %7lu.%lu%s\n", BENCH_NAMES[k], (unsigned long) (cold[k] / per),
+                      (unsigned long) (warm[k] / per), (unsigned long) (warm[k] / len),
+                      (unsigned long) (warm[k] * 10 / len % 10), ((k == BENCH_SCHED) ? "  (per epoch)" : ""));
+    }
+    benchCompare(warm, pause);
+    if (sink == 0x5a5a5a5a) {                                       // Keep the work.
+        Serial.println();
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Bench: debug vs production.
+ * ------------------------------------------------
+ *
+ * Same sample stream & kernels in both builds, so the warm cycles compare directly: a production (GR_DEBUG = 0) row
+ * equal to or below the debug row, & a smaller sketch, is the "no debug overhead" check. This build's run is stored
+ * (NVS, flash write in an inter-epoch gap) for the next bench on the other build; runs at another CPU clock are not
+ * compared.
+ *
+ * @param  const uint32_t * warm  Warm cycles per kernel pass (benchRun()).
+ * @param  bool             pause Relay paused (store without waiting for a gap).
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-06:30am] New.
+ * @see    benchRun().
+ */
+void benchCompare(const uint32_t * warm, bool pause) {
+
+    // -- Local vars. --
+    Preferences         prefs;
+    benchRecord         mine   = {};
+    benchRecord         other  = {};
+    size_t              len    = 0;
+    const char *        key    = DEBUG_BUILD ? BENCH_KEY_DEBUG : BENCH_KEY_PROD;
+    const benchRecord * row[2] = {&mine, &other};                   // Debug, production.
+
+    strncpy(mine.build, BUILD_DATE, sizeof(mine.build) - 1);
+    mine.sketchBytes = ESP.getSketchSize();
+    mine.mhz         = getCpuFrequencyMhz();
+    for (uint8_t k = 0; k < BENCH_KERNELS; k++) {
+        mine.warm[k] = warm[k] / ((k == BENCH_SCHED) ? 1 : BENCH_FRAMES);
+    }
+    if (prefs.begin(CONFIG_NAMESPACE, true)) {                      // Read only. Fails if namespace never written.
+        len = prefs.getBytes(DEBUG_BUILD ? BENCH_KEY_PROD : BENCH_KEY_DEBUG, &other, sizeof(other));
+        prefs.end();
+    }
+    if (!DEBUG_BUILD) {
+        row[0] = &other;
+        row[1] = &mine;
+    }
+    if ((len == sizeof(other)) && (other.mhz == mine.mhz)) {
+        Serial.printf("  %-10s  %-22s %8s  %s\n", "Build", "Build date", "Sketch", "Warm/frame by kernel");
+        for (uint8_t b = 0; b < 2; b++) {
+            Serial.printf("  %-10s  %-22s %8lu ", (b == 0) ? "debug" : "production", row[b]->build,
+                          (unsigned long) row[b]->sketchBytes);
+            for (uint8_t k = 0; k < BENCH_KERNELS; k++) {
+                Serial.printf(" %s %lu", BENCH_NAMES[k], (unsigned long) row[b]->warm[k]);
+            }
+            Serial.println();
+        }
+        Serial.printf("  %-34s %+8ld ", "Production - debug:", (long) row[1]->sketchBytes - (long) row[0]->sketchBytes);
+        for (uint8_t k = 0; k < BENCH_KERNELS; k++) {
+            Serial.printf(" %s %+ld", BENCH_NAMES[k], (long) row[1]->warm[k] - (long) row[0]->warm[k]);
+        }
+        Serial.println();
+    } else {
+        Serial.printf("  Sketch %lu bytes. No %s bench @ %lu MHz stored - run bench on a %s build to compare.\n",
+                      (unsigned long) mine.sketchBytes, (DEBUG_BUILD ? "production" : "debug"),
+                      (unsigned long) mine.mhz, (DEBUG_BUILD ? "GR_DEBUG=0" : "debug"));
+    }
+    if (!pause && !inEpochGap(UPDATE_FLASH_US)) {                   // NVS write is a flash write.
+        Serial.println("  Run not stored (no inter-epoch gap) - bench again.");
+        return;
+    }
+    flashOpBegin();
+    if (!prefs.begin(CONFIG_NAMESPACE, false) || (prefs.putBytes(key, &mine, sizeof(mine)) != sizeof(mine))) {
+        Serial.println("  Run not stored (NVS).");
+    }
+    prefs.end();
+    flashOpEnd();
+}
+
+/**
+ * ------------------------------------------------
+ *      Self test - start.
+ * ------------------------------------------------
+ *
+ * Feeds the bench sample epoch (benchSamples()) into the relay pipeline at ST_RATES, ST_STEP_MS each, & reports where
+ * bytes start to drop & what each stage costs. Internal: a paced generator stands in for Serial0 - its virtual RX
+ * ring (SERIAL0_RX_BUF) overflows when checkRTCMtoRadio() (one byte per loop() pass) falls behind. Loopback: the
+ * generator writes Serial0 TX at the step's baud, jumpered to RX (ZED TX2 unplugged) - the real UART, ring & ISR.
+ * Radio output is sunk, so nothing synthetic goes on air; relay state the test touches is restored afterwards.
+ * Starts with the epoch terminator case (selfTestTerminator()).
+ *
+ * @param  selfTestMode mode Internal or loopback.
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-03:00am] New.
+ * @since  3.1.1 [2026-10-18-06:00am] Epoch terminator case.
+ * @see    checkSelfTest().
+ */
+void selfTestStart(selfTestMode mode) {
+    if ((role != ROLE_RELAY) || (update.stage != UPDATE_IDLE) || (selfTest.mode != ST_OFF)) {
+        Serial.println("selftest: relay role only, not while updating or testing.");
+        return;
+    }
+    memset(&selfTest, 0, sizeof(selfTest));
+    selfTest.len          = benchSamples(selfTest.stream, selfTest.lens);
+    selfTest.saved        = flightRec.now;
+    selfTest.savedDecim   = decim;
+    selfTest.savedHop     = hop;
+    selfTest.savedStation = rtcmStationId;
+    rtcmRx.count = 0;                                               // Start on a frame boundary.
+    rtcmInFrame  = false;
+    selfTest.mode = mode;
+    Serial.printf("\nSelf test (%s): %u steps of %lu ms, radio output sunk.%s\n",
+                  ((mode == ST_LOOPBACK) ? "loopback" : "internal"), (unsigned) ST_STEPS, (unsigned long) ST_STEP_MS,
+                  ((mode == ST_LOOPBACK) ? " Needs RTCM_OUT jumpered to RTCM_IN, ZED TX2 off." : ""));
+    selfTestTerminator();
+}
+
+/**
+ * ------------------------------------------------
+ *      Self test - epoch terminator under decimation.
+ * ------------------------------------------------
+ *
+ * Runs the sample epoch's frame heads through rtcmDecide() with every constellation at ratio 2 & out of phase, so
+ * all MSMs are due to be decimated. Passes if each MSM is decimated except the last (multiple message bit clear),
+ * which the rover needs to close the epoch. Decimation state is restored.
+ *
+ * @return bool Passed.
+ * @since  3.1.1 [2026-10-18-06:00am] New.
+ * @see    selfTestStart().
+ * @see    rtcmDecide().
+ */
+bool selfTestTerminator() {
+
+    // -- Local vars. --
+    static decimState savedDecim;
+           size_t     pos   = 0;
+           uint32_t   fails = 0;
+           uint16_t   held;
+           int8_t     gnss;
+           bool       last;
+
+    savedDecim = decim;
+    decim.enabled   = true;
+    decim.epochOpen = false;
+    decim.epoch     = 0;                                            // Epoch 1 once opened: none due at ratio 2.
+    for (uint8_t c = 0; c < GNSS_NUM; c++) {
+        decim.ratio[c] = 2;
+        decim.phase[c] = 0;
+    }
+    for (uint8_t f = 0; f < BENCH_FRAMES; f++) {
+        held = min(selfTest.lens[f], (uint16_t) RTCM_DECIDE_AT);
+        memcpy(rtcmSentence, &selfTest.stream[pos], held);
+        gnss = rtcmMsmGnss(rtcm3GetMessageType(rtcmSentence));
+        last = !(rtcmSentence[9] & 0x02);
+        if ((gnss >= 0) && (rtcmDecide(held, esp_timer_get_time()) != last)) {
+            fails++;
+        }
+        pos += selfTest.lens[f];
+    }
+    decim          = savedDecim;
+    rtcmRoute      = LINK_BOTH;
+    rtcmFrameEpoch = -1;
+    Serial.printf("Epoch terminator under decimation: %s.\n", ((fails == 0) ? "relayed, OK" : "FAILED"));
+    return (fails == 0);
+}
+
+/**
+ * ------------------------------------------------
+ *      Self test - steps (from loop()).
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-03:00am] New.
+ * @see    selfTestStart().
+ */
+void checkSelfTest() {
+
+    // -- Local vars. --
+    uint32_t         nowMs = millis();
+    selfTestResult * r     = &selfTest.result[selfTest.step];
+    int64_t          elapsed;
+    size_t           n;
+    uint32_t         whole;
+
+    if (selfTest.stepStart == 0) {                                  // Step start.
+        selfTest.stepStart   = max(nowMs, (uint32_t) 1);
+        selfTest.feeding     = true;
+        selfTest.feedStartUs = esp_timer_get_time();
+        selfTest.fed         = 0;
+        selfTest.taken       = 0;
+        selfTest.lost        = 0;
+        selfTest.backlogMax  = 0;
+        selfTest.loops       = loopCount;
+        selfTest.base        = flightRec.now;
+        memset(selfTest.cycles, 0, sizeof(selfTest.cycles));
+        if (selfTest.mode == ST_LOOPBACK) {
+            Serial0.updateBaudRate(ST_RATES[selfTest.step]);
+            rxTs.byteUs = 10 * 1000000 / (int64_t) ST_RATES[selfTest.step];
+        }
+    }
+    if (selfTest.feeding && (nowMs - selfTest.stepStart >= ST_STEP_MS)) {
+        selfTest.feeding   = false;
+        selfTest.feedEndUs = esp_timer_get_time();
+    }
+    if (selfTest.feeding && (selfTest.mode == ST_LOOPBACK)) {       // Keep Serial0 TX full.
+        n = min((size_t) Serial0.availableForWrite(), (size_t) (selfTest.len - selfTest.genPos));
+        Serial0.write(&selfTest.stream[selfTest.genPos], n);
+        selfTest.genPos = (selfTest.genPos + n) % selfTest.len;
+        selfTest.fed   += n;
+        selfTest.backlogMax = max(selfTest.backlogMax, (uint32_t) Serial0.available());
+    }
+    if (selfTest.feeding || (nowMs - selfTest.stepStart < ST_STEP_MS + ST_DRAIN_MS)) {
+        return;
+    }
+
+    // - Step done. -
+    elapsed       = esp_timer_get_time() - selfTest.feedStartUs;
+    whole         = selfTest.fed / selfTest.len * BENCH_FRAMES;     // Frames fed: whole epochs, then the partial one.
+    n             = 0;
+    for (uint8_t i = 0; i < BENCH_FRAMES; i++) {
+        n += selfTest.lens[i];
+        if (n <= selfTest.fed % selfTest.len) {
+            whole++;
+        }
+    }
+    r->rate       = ST_RATES[selfTest.step];
+    r->fed        = selfTest.fed;
+    r->in         = flightRec.now.bytesIn - selfTest.base.bytesIn;
+    r->framesFed  = whole;
+    r->crcErrors  = flightRec.now.crcErrors - selfTest.base.crcErrors;
+    r->framesOk   = flightRec.now.framesIn - selfTest.base.framesIn - r->crcErrors;
+    r->overflows  = (selfTest.mode == ST_INTERNAL) ? selfTest.lost
+                                                   : flightRec.now.rxOverflows - selfTest.base.rxOverflows;
+    r->backlogMax = selfTest.backlogMax;
+    r->loopRate   = (uint32_t) ((uint64_t) (loopCount - selfTest.loops) * 1000000 / elapsed);
+    for (uint8_t s = 0; s < ST_STAGES; s++) {
+        r->cpu[s] = (uint16_t) (selfTest.cycles[s] * 1000 / ((uint64_t) elapsed * getCpuFrequencyMhz()));
+    }
+    Serial.printf("selftest %lu bps: %lu/%lu frames.\n", (unsigned long) r->rate, (unsigned long) r->framesOk,
+                  (unsigned long) r->framesFed);
+    selfTest.stepStart = 0;
+    if (++selfTest.step < ST_STEPS) {                               // Next step starts on a frame boundary.
+        selfTest.genPos = 0;
+        rtcmRx.count    = 0;
+        rtcmInFrame     = false;
+        return;
+    }
+    selfTestEnd();
+}
+
+/**
+ * ------------------------------------------------
+ *      Self test - internal generator bytes waiting.
+ * ------------------------------------------------
+ *
+ * Bytes due at the step's rate since the feed started, less those read; beyond SERIAL0_RX_BUF they are lost (the
+ * generator skips them, as a real overflow would).
+ *
+ * @return int Bytes in the virtual RX ring.
+ * @since  3.1.1 [2026-10-18-03:00am] New.
+ * @see    checkRTCMtoRadio().
+ */
+int HOT_FN selfTestAvailable() {
+
+    // -- Local vars. --
+    int64_t  until = selfTest.feeding ? esp_timer_get_time() : selfTest.feedEndUs;
+    uint32_t due;
+    uint32_t backlog;
+
+    if (selfTest.stepStart == 0) {
+        return 0;
+    }
+    due     = (uint32_t) ((until - selfTest.feedStartUs) * ST_RATES[selfTest.step] / 10000000);
+    backlog = due - selfTest.taken - selfTest.lost;
+    if (backlog > SERIAL0_RX_BUF) {                                 // Overflow - drop the excess.
+        selfTest.lost  += backlog - SERIAL0_RX_BUF;
+        selfTest.genPos = (selfTest.genPos + backlog - SERIAL0_RX_BUF) % selfTest.len;
+        backlog         = SERIAL0_RX_BUF;
+    }
+    selfTest.fed        = due;
+    selfTest.backlogMax = max(selfTest.backlogMax, backlog);
+    return (int) backlog;
+}
+
+/**
+ * ------------------------------------------------
+ *      Self test - stage cycles.
+ * ------------------------------------------------
+ *
+ * @param  selfTestStage stage  Stage just run.
+ * @param  uint32_t *    cycles Cycle count at stage start (updated).
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-03:00am] New.
+ * @see    checkRTCMtoRadio().
+ */
+void HOT_FN selfTestTime(selfTestStage stage, uint32_t * cycles) {
+    uint32_t now = esp_cpu_get_cycle_count();
+    selfTest.cycles[stage] += now - *cycles;
+    *cycles = now;
+}
+
+/**
+ * ------------------------------------------------
+ *      Self test - restore & report.
+ * ------------------------------------------------
+ *
+ * The ceiling is the highest rate where every fed frame came out with no overflow or CRC error.
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-03:00am] New.
+ * @see    checkSelfTest().
+ */
+void selfTestEnd() {
+
+    // -- Local vars. --
+    uint32_t ceiling = 0;
+    bool     clean   = true;
+    uint16_t total;
+
+    if (selfTest.mode == ST_LOOPBACK) {
+        Serial0.updateBaudRate(baud.rate);
+        rxTs.byteUs = 10 * 1000000 / (int64_t) baud.rate;
+    }
+    while (Serial0.available() > 0) {                               // Stale (internal) or synthetic (loopback) input.
+        Serial0.read();
+        rxTs.readIdx++;
+    }
+    flightRec.now = selfTest.saved;
+    decim         = selfTest.savedDecim;
+    hop           = selfTest.savedHop;
+    rtcmStationId = selfTest.savedStation;
+    rtcmRx.count  = 0;
+    rtcmInFrame   = false;
+    rtcmResync    = true;
+    selfTest.mode = ST_OFF;
+
+    Serial.printf("\nSelf test, CPU %lu MHz, %lu radio bytes sunk. CPU %% per stage (%s, %s, %s, %s):\n",
+                  (unsigned long) getCpuFrequencyMhz(), (unsigned long) selfTest.sunk, ST_STAGE_NAMES[0],
+                  ST_STAGE_NAMES[1], ST_STAGE_NAMES[2], ST_STAGE_NAMES[3]);
+    Serial.println("     Rate   Fed B    In B  Frames  Ok  CRC  Ovf  Ring  Loop/s   CPU %");
+    for (uint8_t i = 0; i < ST_STEPS; i++) {
+        selfTestResult * r = &selfTest.result[i];
+        total = r->cpu[0] + r->cpu[1] + r->cpu[2] + r->cpu[3];
+        Serial.printf("  %7lu  %6lu  %6lu  %6lu  %6lu  %3lu  %4lu  %4lu  %6lu  %u.%u %u.%u %u.%u %u.%u = %u.%u\n",
+                      (unsigned long) r->rate, (unsigned long) r->fed, (unsigned long) r->in,
+                      (unsigned long) r->framesFed, (unsigned long) r->framesOk, (unsigned long) r->crcErrors,
+                      (unsigned long) r->overflows, (unsigned long) r->backlogMax, (unsigned long) r->loopRate,
+                      r->cpu[0] / 10, r->cpu[0] % 10, r->cpu[1] / 10, r->cpu[1] % 10, r->cpu[2] / 10, r->cpu[2] % 10,
+                      r->cpu[3] / 10, r->cpu[3] % 10, total / 10, total % 10);
+        if (clean && (r->overflows == 0) && (r->crcErrors == 0) && (r->framesOk >= r->framesFed)) {
+            ceiling = r->rate;
+        } else {
+            clean = false;
+        }
+    }
+    if (ceiling == ST_RATES[ST_STEPS - 1]) {
+        Serial.printf("No drops up to %lu bps.\n", (unsigned long) ceiling);
+    } else {
+        Serial.printf("Ceiling %lu bps - drops begin at the next step.\n", (unsigned long) ceiling);
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Hot path - loop() pass time vs flash ops.
+ * ------------------------------------------------
+ *
+ * Called at the top of loop(). Times the previous pass if the relay was busy then (parser in a frame or Serial0
+ * input pending) & files it by what flash was doing: a flash op inside the pass, shortly after one, or neither.
+ * "flash": the op ran synchronously in this loop() pass (checkConfig(), checkUpdate()), so the byte path stood still
+ * for the whole erase/write in any build - GR_IRAM does not shorten these; only IRAM ISRs ran meanwhile (not the
+ * UART RX ISR). "after": the cache refills from flash - the byte path misses unless it runs from IRAM. Compare the
+ * "after" column of a GR_IRAM=0 & a GR_IRAM=1 build over the same update / cfg commits.
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-01:00am] New.
+ * @since  3.1.1 [2026-10-18-06:00am] What the classes mean (flash ops stop the relay in any build).
+ * @see    flashOpBegin().
+ */
+void hotPass() {
+
+    // -- Local vars. --
+    uint32_t now = micros();
+    uint32_t us;
+    uint8_t  cls;
+
+    if (hot.busy && (hot.lastPass != 0)) {
+        us  = now - hot.lastPass;
+        cls = PASS_QUIET;
+        if (hot.flashOps != hot.flashOpsAtPass) {
+            cls = PASS_FLASH;
+        } else if ((hot.flashOps > 0) && (hot.lastPass - hot.flashEnd < FLASH_AFTER_US)) {
+            cls = PASS_AFTER;
+        }
+        for (size_t i = 0; i < PASS_BUCKETS; i++) {
+            if (us < PASS_BUCKET_US[i]) {
+                hot.hist[cls][i]++;
+                break;
+            }
+        }
+        if (us > PASS_OUTLIER_US) {
+            hot.outliers[cls]++;
+        }
+        hot.maxUs[cls] = max(hot.maxUs[cls], us);
+    }
+    hot.lastPass       = now;
+    hot.busy           = rtcmInFrame || (Serial0.available() > 0);
+    hot.flashOpsAtPass = hot.flashOps;
+}
+
+/**
+ * ------------------------------------------------
+ *      Flash op (NVS commit, OTA sector) start.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-01:00am] New.
+ * @see    flashOpEnd().
+ * @see    checkConfig().
+ * @see    checkUpdate().
+ */
+void flashOpBegin() {
+    hot.flashStart = micros();
+}
+
+/**
+ * ------------------------------------------------
+ *      Flash op end.
+ * ------------------------------------------------
+ *
+ * Longest op & op count; hotPass() files the pass it fell in as "flash" & the next FLASH_AFTER_US as "after".
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-01:00am] New.
+ * @see    flashOpBegin().
+ * @see    hotPass().
+ */
+void flashOpEnd() {
+    hot.flashEnd   = micros();
+    hot.flashMaxUs = max(hot.flashMaxUs, hot.flashEnd - hot.flashStart);
+    hot.flashOps++;
+}
+
+/**
+ * ------------------------------------------------
+ *      Clear hot path stats (before/after runs).
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-01:00am] New.
+ */
+void hotClear() {
+    memset(&hot, 0, sizeof(hot));
+    hot.since = millis();
+}
+
+/**
+ * ------------------------------------------------
+ *      Display hot path stats.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.1 [2026-10-18-01:00am] New.
+ * @since  3.1.1 [2026-10-18-06:00am] Column key.
+ * @see    checkSerialUSB().
+ */
+void showHot() {
+    Serial.printf("\nHot path: %s (GR_IRAM=%d). Flash ops %lu, longest %lu us. Busy loop() passes, last %lu s:\n",
+                  (IRAM_BUILD ? "IRAM" : "flash"), GR_IRAM, (unsigned long) hot.flashOps,
+                  (unsigned long) hot.flashMaxUs, (unsigned long) ((millis() - hot.since) / 1000));
+    Serial.printf("  Under(us)");
+    for (size_t c = 0; c < PASS_CLASSES; c++) {
+        Serial.printf("  %7s", PASS_NAMES[c]);
+    }
+    Serial.println();
+    for (size_t i = 0; i < PASS_BUCKETS; i++) {
+        if (PASS_BUCKET_US[i] == UINT32_MAX) {
+            Serial.printf("  %9s", "more");
+        } else {
+            Serial.printf("  %9lu", (unsigned long) PASS_BUCKET_US[i]);
+        }
+        for (size_t c = 0; c < PASS_CLASSES; c++) {
+            Serial.printf("  %7lu", (unsigned long) hot.hist[c][i]);
+        }
+        Serial.println();
+    }
+    Serial.printf("  %9s", "> 1 ms");
+    for (size_t c = 0; c < PASS_CLASSES; c++) {
+        Serial.printf("  %7lu", (unsigned long) hot.outliers[c]);
+    }
+    Serial.printf("\n  %9s", "max");
+    for (size_t c = 0; c < PASS_CLASSES; c++) {
+        Serial.printf("  %7lu", (unsigned long) hot.maxUs[c]);
+    }
+    Serial.println("\nflash = op in the pass (relay stopped, any build); after = cache refill (GR_IRAM helps).");
+    Serial.println("\"hot clear\" restarts the counts.");
+}
+
+/**
+ * ------------------------------------------------
+ *      Wrap time difference into +/- half a week.
+ * ------------------------------------------------
+ *
+ * @param  int64_t ms Time difference (ms).
+ * @return int64_t Wrapped difference (ms).
+ * @since  3.1.0 [2026-10-17-04:15pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ */
+int64_t HOT_FN gpsWeekWrap(int64_t ms) {
+    ms %= GPS_WEEK_MS;
+    if (ms >= GPS_WEEK_MS / 2) {
+        ms -= GPS_WEEK_MS;
+    } else if (ms < -GPS_WEEK_MS / 2) {
+        ms += GPS_WEEK_MS;
+    }
+    return ms;
+}
+
+/**
+ * ------------------------------------------------
+ *      MSM epoch time as GPS time of week.
+ * ------------------------------------------------
+ *
+ * MSM header: type (12), station (12), epoch time (30), multiple message bit (1), ... Epoch time is ms of week in
+ * each system's own time scale: GPS, Galileo, QZSS, SBAS & NavIC follow GPS time; BeiDou BDT = GPS - 14 s;
+ * GLONASS is day of week (3) + ms of day (27) in UTC(SU) + 3 h.
+ *
+ * @param  int8_t gnss Constellation (rtcmMsmGnss()).
+ * @return int64_t GPS ms of week, -1 if unknown.
+ * @since  3.1.0 [2026-10-17-04:15pm] New.
+ * @since  3.1.0 [2026-10-17-09:00pm] bitReader.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    rtcmDecide().
+ */
+int64_t HOT_FN msmEpochGps(int8_t gnss) {
+
+    // -- Local vars. --
+    const uint8_t * frame = (const uint8_t *) rtcmSentence;
+          int64_t   ms;
+          uint32_t  dow;
+          bitReader r;
+
+    bitsInit(&r, frame, RTCM_DECIDE_AT, 48);
+    switch (gnss) {
+        case 1:                                                     // GLONASS.
+            dow = bitsGet(&r, 3);
+            if (dow > 6) {                                          // Day unknown.
+                return -1;
+            }
+            ms = (int64_t) dow * 86400000 + bitsGet(&r, 27) - GLO_UTC_MS + GPS_LEAP_MS;
+            break;
+        case 5:                                                     // BeiDou.
+            ms = (int64_t) bitsGet(&r, 30) + BDS_GPS_MS;
+            break;
+        default:
+            ms = bitsGet(&r, 30);
+    }
+    ms %= GPS_WEEK_MS;
+    return (ms < 0) ? ms + GPS_WEEK_MS : ms;
+}
+
+/**
+ * ------------------------------------------------
+ *      Clock offset sample.
+ * ------------------------------------------------
+ *
+ * Local clock - GNSS time is estimated as the minimum of (first MSM arrival - epoch time) over the last LAT_WINDOW
+ * epochs, i.e. the fastest epoch in the window is taken as ZED_LATENCY_FLOOR. A window (rather than all-time)
+ * minimum follows crystal drift. Samples are unwrapped against the current estimate, so GPS week rollover is seamless.
+ *
+ * @param  int64_t diff Arrival (local us) - epoch (GPS us of week).
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-04:15pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    rtcmDecide().
+ */
+void HOT_FN latencySample(int64_t diff) {
+    if (latCount > 0) {
+        diff = latOffset + gpsWeekWrap((diff - latOffset) / 1000) * 1000 + (diff - latOffset) % 1000;
+    }
+    latRing[latHead] = diff;
+    latHead  = (latHead + 1) % LAT_WINDOW;
+    latCount = min((uint8_t) (latCount + 1), LAT_WINDOW);
+    latOffset = latRing[0];
+    for (uint8_t i = 1; i < latCount; i++) {
+        latOffset = min(latOffset, latRing[i]);
+    }
+    latOffset -= ZED_LATENCY_FLOOR;
+}
+
+/**
+ * ------------------------------------------------
+ *      Epoch to air latency of relayed MSM.
+ * ------------------------------------------------
+ *
+ * @param  int8_t  gnss  Constellation.
+ * @param  int64_t epoch Epoch (GPS ms of week).
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-04:15pm] New.
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    rtcmFrameDone().
+ */
+void HOT_FN latencyFrame(int8_t gnss, int64_t epoch) {
+
+    // -- Local vars. --
+    latencyStats * s = &latStats[gnss];
+    int64_t        epochLocal;
+    int32_t        air;
+
+    if (latCount == 0) {
+        return;
+    }
+    epochLocal = latOffset + epoch * 1000;                          // Epoch on the local clock (us).
+    air        = (int32_t) gpsWeekWrap((radioAirUntil - epochLocal) / 1000);
+    s->lastIn  = (int32_t) gpsWeekWrap((rtcmLastByte  - epochLocal) / 1000);
+    s->last    = air;
+    s->avg     = (s->n == 0) ? air : s->avg + (air - s->avg) / 8;
+    s->min     = (s->n == 0) ? air : min(s->min, air);
+    s->max     = (s->n == 0) ? air : max(s->max, air);
+    s->n++;
+}
+
+/**
+ * ------------------------------------------------
+ *      Display epoch to air latency.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-04:15pm] New.
+ * @since  3.1.1 [2026-10-18-02:30am] Arrival timestamp error bound.
+ * @see    checkSerialUSB().
+ */
+void showLatency() {
+    Serial.printf("\nEpoch to air latency (ms), clock offset from %u epochs, ZED floor %lu ms:\n",
+                  (unsigned) latCount, (unsigned long) (ZED_LATENCY_FLOOR / 1000));
+    Serial.println("  GNSS   Frames  In(last)  Air(last)  Avg   Min   Max");
+    for (size_t i = 0; i < GNSS_NUM; i++) {
+        if (latStats[i].n == 0) {
+            continue;
+        }
+        Serial.printf("  %-6s %6lu  %8ld  %9ld  %4ld  %4ld  %4ld\n", GNSS_NAMES[i], (unsigned long) latStats[i].n,
+                      (long) latStats[i].lastIn, (long) latStats[i].last, (long) latStats[i].avg,
+                      (long) latStats[i].min, (long) latStats[i].max);
+    }
+    Serial.printf("Arrival timestamps: UART RX events (FIFO %u bytes, timeout %u symbols), %lu events, error bound "
+                  "%lu us (byte %lu + jitter max %lu, avg %lu).\n", (unsigned) RX_FIFO_FULL, (unsigned) RX_TIMEOUT_SYM,
+                  (unsigned long) rxTs.events, (unsigned long) (rxTs.byteUs + rxTs.jitterMax),
+                  (unsigned long) rxTs.byteUs, (unsigned long) rxTs.jitterMax, (unsigned long) rxTs.jitterAvg);
+    Serial.printf("loop() read lag (error of read time stamps): avg %lu us, max %lu us. No mark: %lu bytes.\n",
+                  (unsigned long) rxTs.lagAvg, (unsigned long) rxTs.lagMax, (unsigned long) rxTs.fallbacks);
+}
+
+/**
+ * ------------------------------------------------
+ *      Set power mode.
+ * ------------------------------------------------
+ *
+ * @param  powerMode mode POWER_RUN, POWER_IDLE or POWER_SLEEP.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-06:00pm] New.
+ * @see    checkPower().
+ */
+void setPowerMode(powerMode mode) {
+    if (power.slow) {
+        setCpuFrequencyMhz(CPU_MHZ_RUN);
+        power.slow = false;
+    }
+    if (mode == POWER_SLEEP) {                                      // Backup wake: RTCM_IN start bit.
+        gpio_wakeup_enable((gpio_num_t) RTCM_IN, GPIO_INTR_LOW_LEVEL);
+        esp_sleep_enable_gpio_wakeup();
+    } else {
+        gpio_wakeup_disable((gpio_num_t) RTCM_IN);
+    }
+    power.mode       = mode;
+    power.since      = esp_timer_get_time();
+    power.idleUs     = 0;
+    power.sleepUs    = 0;
+    power.sleeps     = 0;
+    power.lateWakes  = 0;
+    power.marginMin  = INT32_MAX;
+    power.marginLast = 0;
+    power.wokeAt     = 0;
+}
+
+/**
+ * ------------------------------------------------
+ *      Idle or sleep in the inter-epoch gap.
+ * ------------------------------------------------
+ *
+ * The ZED sends one burst per epoch. Once input has been quiet for POWER_GAP_US & the modelled HC-12 queue has
+ * drained, the gap has started:
+ *   POWER_IDLE  - CPU to CPU_MHZ_IDLE & loop() blocks one tick at a time, so the idle task sits in WFI. The UARTs
+ *                 keep running, so the first bytes of the next burst are buffered, never lost (<= 1 ms late).
+ *   POWER_SLEEP - light sleep with a timer wake POWER_GUARD_US ahead of the predicted burst (burst period is learnt
+ *                 from burst starts). UART clocks stop in light sleep, so RTCM_IN low is a backup wake; if that fires
+ *                 the first bytes are lost (counted as late wakes, the parser resyncs). USB console drops while
+ *                 asleep. "cfg power 2" is committed & applied at boot, so sleep mode only idles for the first
+ *                 POWER_SLEEP_GRACE after boot: reset, then change the mode on the console within that window.
+ * Burst start restores CPU_MHZ_RUN. Suspended during a firmware update.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-06:00pm] New.
+ * @since  3.1.0 [2026-10-17-07:00pm] Not during update.
+ * @since  3.1.1 [2026-10-18-05:00am] No light sleep for POWER_SLEEP_GRACE after boot.
+ * @see    loop().
+ */
+void checkPower() {
+
+    // -- Local vars. --
+    int64_t now;
+    int64_t next;
+    int64_t start;
+
+    if ((power.mode == POWER_RUN) || (update.stage != UPDATE_IDLE)) {
+        return;
+    }
+    now = esp_timer_get_time();
+    if (Serial0.available() > 0) {                                  // Burst.
+        if (power.slow) {
+            setCpuFrequencyMhz(CPU_MHZ_RUN);
+            power.slow = false;
+        }
+        if (power.inGap) {                                          // Burst start.
+            power.inGap = false;
+            if (power.burstStart != 0 && (now - power.burstStart) < 3000000) {
+                power.periodUs = (power.periodUs == 0) ? (now - power.burstStart)
+                                                       : power.periodUs + ((now - power.burstStart) - power.periodUs) / 4;
+            }
+            power.burstStart = now;
+            if (power.wokeAt != 0) {                                // Timer wake margin.
+                power.marginLast = (int32_t) ((now - power.wokeAt) / 1000);
+                power.marginMin  = min(power.marginMin, power.marginLast);
+                power.wokeAt     = 0;
+            }
+        }
+        return;
+    }
+    if (((now - rtcmLastByte) < POWER_GAP_US) || (now < radioAirUntil) || rtcmInFrame) {
+        return;                                                     // Still in the burst, or HC-12 still sending.
+    }
+    power.inGap = true;
+    if ((power.mode == POWER_SLEEP) && (power.periodUs > 0) && (millis() > POWER_SLEEP_GRACE)) {
+        next = power.burstStart + power.periodUs;
+        while (next < now + POWER_GUARD_US) {                       // Missed burst(s) - predict the next.
+            next += power.periodUs;
+        }
+        if ((next - POWER_GUARD_US - now) >= POWER_MIN_SLEEP_US) {
+            Serial1.flush();                                        // UART1 TX stops in light sleep.
+            esp_sleep_enable_timer_wakeup((uint64_t) (next - POWER_GUARD_US - now));
+            start = esp_timer_get_time();
+            esp_light_sleep_start();
+            power.wokeAt = esp_timer_get_time();
+            power.sleepUs += power.wokeAt - start;
+            power.sleeps++;
+            if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO) {
+                power.lateWakes++;
+                power.wokeAt = 0;
+            }
+            return;
+        }
+    }
+    if (!power.slow) {
+        setCpuFrequencyMhz(CPU_MHZ_IDLE);
+        power.slow = true;
+    }
+    start = esp_timer_get_time();
+    delay(1);                                                       // Idle task WFI until the next tick.
+    power.idleUs += esp_timer_get_time() - start;
+}
+
+/**
+ * ------------------------------------------------
+ *      In an inter-epoch gap?
+ * ------------------------------------------------
+ *
+ * True if the current burst is over (input quiet TELEM_QUIET, no frame open, HC-12 drained) & the next epoch is
+ * predicted at least needUs away. Flash erase & write stall interrupts whose handlers are not in IRAM (the UART
+ * driver's), so they must not overlap a burst - the 128 byte RX FIFO fills in ~22 ms @ 57600 bps.
+ *
+ * @param  int64_t needUs Time needed (us).
+ * @return bool True if there is time.
+ * @since  3.1.0 [2026-10-17-07:00pm] New.
+ * @see    checkUpdate().
+ */
+bool inEpochGap(int64_t needUs) {
+
+    // -- Local vars. --
+    int64_t now = esp_timer_get_time();
+    int64_t next;
+
+    if (((now - rtcmLastByte) / 1000 < TELEM_QUIET) || rtcmInFrame || (now < radioAirUntil)) {
+        return false;
+    }
+    if ((decim.periodMs == 0) || (decim.epochStart == 0)) {         // Epoch cadence unknown - wait for a long quiet.
+        return (now - rtcmLastByte) / 1000 >= INPUT_STALL;
+    }
+    next = decim.epochStart + (int64_t) decim.periodMs * 1000;
+    while (next < now) {                                            // Missed epoch(s).
+        next += (int64_t) decim.periodMs * 1000;
+    }
+    return (next - now) >= needUs + 20000;                          // Epoch start is a few frames into the burst.
+}
+
+/**
+ * ------------------------------------------------
+ *      Start firmware update.
+ * ------------------------------------------------
+ *
+ * Protocol (tools/usb_update.py): "update" -> "UPDATE READY"; host sends "<size> [md5]\n" -> "UPDATE BEGIN" or
+ * "UPDATE FAIL ..."; host streams the image (USB flow control throttles it); progress "UPDATE n/size"; then
+ * "UPDATE OK ..." & "UPDATE REBOOT", or "UPDATE FAIL ...".
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-07:00pm] New.
+ * @see    checkUpdate().
+ */
+void startUpdate() {
+    memset(&update, 0, sizeof(update));
+    update.stage     = UPDATE_HEADER;
+    update.lastRx    = millis();
+    update.started   = millis();
+    update.overflows = flightRec.now.rxOverflows;
+    update.crcErrors = flightRec.now.crcErrors;
+    Serial.println("UPDATE READY");
+}
+
+/**
+ * ------------------------------------------------
+ *      Firmware update - stop.
+ * ------------------------------------------------
+ *
+ * @param  const char * why Reason.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-07:00pm] New.
+ * @see    checkUpdate().
+ */
+void failUpdate(const char * why) {
+    if (update.stage == UPDATE_DATA) {
+        Update.abort();
+    }
+    Serial.printf("UPDATE FAIL %s\n", why);
+    update.stage = UPDATE_IDLE;
+}
+
+/**
+ * ------------------------------------------------
+ *      Firmware update - receive, write & reboot.
+ * ------------------------------------------------
+ *
+ * Runs in loop() instead of checkSerialUSB(), so RTCM keeps flowing. USB bytes fill one sector buffer; the sector
+ * is only erased & written inside an inter-epoch gap (inEpochGap()). While it waits, USB input is not read & the host
+ * blocks. Update.end() checks the image (& MD5 if given) & selects the new slot. Reboot waits for a gap too.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-07:00pm] New.
+ * @see    startUpdate().
+ * @link   https://docs.espressif.com/projects/esp-idf/en/stable/esp32c6/api-guides/performance/speed.html.
+ */
+void checkUpdate() {
+
+    // -- Local vars. --
+    static bool    waiting = false;                                 // Full sector waiting for a gap.
+           size_t  n;
+           int     c;
+           int64_t start;
+           char *  md5;
+
+    switch (update.stage) {
+        case UPDATE_HEADER:
+            while ((c = Serial.read()) >= 0) {
+                update.lastRx = millis();
+                if ((c != '\n') && (c != '\r')) {
+                    if (update.headerLen < sizeof(update.header) - 1) {
+                        update.header[update.headerLen++] = (char) c;
+                    }
+                    continue;
+                }
+                if (update.headerLen == 0) {
+                    continue;
+                }
+                update.size = strtoul(update.header, &md5, 10);
+                while (*md5 == ' ') {
+                    md5++;
+                }
+                if ((update.size == 0) || !Update.begin(update.size)) {
+                    failUpdate(update.size == 0 ? "size" : Update.errorString());
+                    return;
+                }
+                if ((strlen(md5) == 32) && !Update.setMD5(md5)) {
+                    Update.abort();
+                    failUpdate("md5");
+                    return;
+                }
+                update.stage = UPDATE_DATA;
+                Serial.printf("UPDATE BEGIN %lu\n", (unsigned long) update.size);
+                return;
+            }
+            break;
+        case UPDATE_DATA:
+            n = min((size_t) Serial.available(), (size_t) min((uint32_t) (UPDATE_SECTOR - update.fill),
+                                                             update.size - update.received));
+            if (n > 0) {
+                n = Serial.readBytes(updateBuf + update.fill, n);
+                update.fill     += n;
+                update.received += n;
+                update.lastRx    = millis();
+            }
+            if ((update.fill == UPDATE_SECTOR) || ((update.fill > 0) && (update.received == update.size))) {
+                if (!inEpochGap(UPDATE_FLASH_US)) {
+                    if (!waiting) {
+                        update.deferred++;
+                        waiting = true;
+                    }
+                    return;
+                }
+                waiting = false;
+                start = esp_timer_get_time();
+                flashOpBegin();
+                if (Update.write(updateBuf, update.fill) != update.fill) {
+                    flashOpEnd();
+                    failUpdate(Update.errorString());
+                    return;
+                }
+                if (update.written + update.fill == update.size) {  // Last sector - verify & select slot.
+                    if (!Update.end()) {
+                        flashOpEnd();
+                        failUpdate(Update.errorString());
+                        return;
+                    }
+                    update.stage = UPDATE_REBOOT;
+                }
+                flashOpEnd();
+                update.flashMaxUs = max(update.flashMaxUs, (uint32_t) (esp_timer_get_time() - start));
+                update.flashWrites++;
+                update.written += update.fill;
+                update.fill     = 0;
+                if ((update.written % 65536 == 0) || (update.stage == UPDATE_REBOOT)) {
+                    Serial.printf("UPDATE %lu/%lu\n", (unsigned long) update.written, (unsigned long) update.size);
+                }
+                if (update.stage == UPDATE_REBOOT) {
+                    Serial.printf("UPDATE OK %lu bytes in %lu s, %lu sector writes (longest %lu ms, %lu waited for a gap), "
+                                  "RX overflows +%lu, CRC errors +%lu.\n", (unsigned long) update.size,
+                                  (unsigned long) ((millis() - update.started) / 1000), (unsigned long) update.flashWrites,
+                                  (unsigned long) (update.flashMaxUs / 1000), (unsigned long) update.deferred,
+                                  (unsigned long) (flightRec.now.rxOverflows - update.overflows),
+                                  (unsigned long) (flightRec.now.crcErrors - update.crcErrors));
+                }
+                return;
+            }
+            break;
+        case UPDATE_REBOOT:
+            if (inEpochGap(UPDATE_REBOOT_US)) {
+                Serial.println("UPDATE REBOOT");
+                Serial.flush();
+                Serial1.flush();
+                esp_restart();
+            }
+            return;
+        default:
+            return;
+    }
+    if (millis() - update.lastRx > UPDATE_TIMEOUT) {
+        failUpdate("timeout");
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Config defaults (compiled in).
+ * ------------------------------------------------
+ *
+ * @param  relayConfig * cfg Config to fill.
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-08:00pm] New.
+ * @since  3.1.1 [2026-10-18-05:00am] 2nd radio on for a repeater (default or running).
+ * @see    loadConfig().
+ */
+void configDefaults(relayConfig * cfg) {
+    memset(cfg, 0, sizeof(relayConfig));
+    cfg->version      = CONFIG_VERSION;
+    cfg->size         = sizeof(relayConfig);
+    cfg->serial0Speed = SERIAL0_SPEED;
+    cfg->serial1Speed = SERIAL1_SPEED;
+    cfg->telemPeriod  = TELEM_PERIOD;
+    cfg->debugRad     = 0;
+    cfg->decim        = 1;
+    cfg->power        = POWER_RUN;
+    cfg->radio2       = ((GR_ROLE == ROLE_REPEATER) || (role == ROLE_REPEATER)) ? RADIO2_DUP : RADIO2_OFF;
+    cfg->hop          = HOP_RTCM;
+    cfg->role         = GR_ROLE;
+    cfg->autobaud     = 1;
+}
+
+/**
+ * ------------------------------------------------
+ *      Config field change valid?
+ * ------------------------------------------------
+ *
+ * Ranges are checked against CONFIG_FIELDS; this checks fields together. The repeater role needs the 2nd HC-12 on
+ * (GR_RADIO2 & cfg radio2 dup/split) - on Serial1's own channel it would transmit over the base's burst. Checked
+ * against both the pending role & the running one (role applies at reboot, radio2 at once).
+ *
+ * @param  const relayConfig * cfg Config (live or with a field changed).
+ * @return bool True if valid.
+ * @since  3.1.1 [2026-10-18-05:00am] New.
+ * @see    configCommand().
+ * @see    binRequest().
+ */
+bool configValid(const relayConfig * cfg) {
+    if ((cfg->role != ROLE_REPEATER) && (role != ROLE_REPEATER)) {
+        return true;
+    }
+    return RADIO2_BUILD && (cfg->radio2 != RADIO2_OFF);
+}
+
+/**
+ * ------------------------------------------------
+ *      Config CRC-24Q.
+ * ------------------------------------------------
+ *
+ * @param  const relayConfig * cfg Config.
+ * @return uint32_t CRC-24Q of everything before the crc field.
+ * @since  3.1.0 [2026-10-17-08:00pm] New.
+ */
+uint32_t configCrc(const relayConfig * cfg) {
+    return crc24q((const uint8_t *) cfg, offsetof(relayConfig, crc));
+}
+
+/**
+ * ------------------------------------------------
+ *      Load config from NVS & apply.
+ * ------------------------------------------------
+ *
+ * One blob read, before Serial0.begin(). A missing, short, other-version or bad-CRC blob falls back to the compiled
+ * in defaults (nothing is written until "cfg commit"). Read time is in the boot timeline ("config loaded").
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-08:00pm] New.
+ * @see    setup().
+ */
+void loadConfig() {
+
+    // -- Local vars. --
+    Preferences prefs;
+    int64_t     start = esp_timer_get_time();
+    size_t      len   = 0;
+
+    configDefaults(&config);
+    configSource = "defaults (none stored)";
+    if (prefs.begin(CONFIG_NAMESPACE, true)) {                      // Read only. Fails if namespace never written.
+        len = prefs.getBytes(CONFIG_KEY, &configStored, sizeof(configStored));
+        prefs.end();
+    }
+    if (len == sizeof(configStored)) {
+        if ((configStored.version != CONFIG_VERSION) || (configStored.size != sizeof(relayConfig))) {
+            configSource = "defaults (stored version differs)";
+        } else if (configStored.crc != configCrc(&configStored)) {
+            configSource = "defaults (stored CRC bad)";
+        } else {
+            config       = configStored;
+            configSource = "NVS";
+        }
+    } else if (len > 0) {
+        configSource = "defaults (stored size differs)";
+    }
+    configStored = config;
+    configLoadUs = (uint32_t) (esp_timer_get_time() - start);
+    applyConfig();
+    bootMark(BOOT_CONFIG);
+}
+
+/**
+ * ------------------------------------------------
+ *      Apply run time config.
+ * ------------------------------------------------
+ *
+ * Reboot-only fields (serial speeds, role) are not touched: startSerial() takes them once at boot & run time math
+ * uses the running values (radioSpeed, radioByteUs, baud.rate, role), so a pending change can't skew the airtime
+ * model or the budgets before the UART actually runs at it.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-08:00pm] New.
+ * @since  3.1.1 [2026-10-18-05:00am] Reboot-only fields skipped (radioByteUs set in startSerial()).
+ * @see    loadConfig().
+ * @see    configCommand().
+ */
+void applyConfig() {
+    if (!RADIO2_BUILD) {                                            // Blob from a GR_RADIO2 build.
+        config.radio2 = RADIO2_OFF;
+    }
+    debugRad      = (config.debugRad != 0);
+    decim.enabled = (config.decim != 0);
+    if (power.mode != (powerMode) config.power) {
+        setPowerMode((powerMode) config.power);
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Config console command.
+ * ------------------------------------------------
+ *
+ * cfg                 - show.
+ * cfg <name> <value>  - set (applied now unless marked reboot; kept in RAM until commit).
+ * cfg commit          - write to NVS in the next inter-epoch gap (coalesced, skipped if unchanged).
+ * cfg default         - back to compiled in defaults (then commit).
+ *
+ * @param  char * args Arguments (NULL if none).
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-08:00pm] New.
+ * @see    checkSerialUSB().
+ */
+void configCommand(char * args) {
+
+    // -- Local vars. --
+    char *      value;
+    char *      end;
+    uint32_t    v;
+    relayConfig next;                                               // Config with the field changed (validity).
+
+    if ((args == NULL) || (*args == '\0')) {
+        showConfig();
+        return;
+    }
+    if (strcmp(args, "commit") == 0) {
+        configPending = true;
+        Serial.println("cfg commit queued (next gap).");
+        return;
+    }
+    if (strcmp(args, "default") == 0) {
+        configDefaults(&config);
+        applyConfig();
+        Serial.println("cfg defaults set (cfg commit to store).");
+        return;
+    }
+    value = strchr(args, ' ');
+    if (value != NULL) {
+        *value++ = '\0';
+    }
+    for (size_t i = 0; i < CONFIG_NUM_FIELDS; i++) {
+        if (strcmp(args, CONFIG_FIELDS[i].name) != 0) {
+            continue;
+        }
+        if (value == NULL) {
+            Serial.printf("%s = %lu\n", CONFIG_FIELDS[i].name, (unsigned long) (config.*CONFIG_FIELDS[i].field));
+            return;
+        }
+        v = strtoul(value, &end, 10);
+        if ((*end != '\0') || (v < CONFIG_FIELDS[i].lo) || (v > CONFIG_FIELDS[i].hi)) {
+            Serial.printf("%s: %lu..%lu.\n", CONFIG_FIELDS[i].name, (unsigned long) CONFIG_FIELDS[i].lo,
+                          (unsigned long) CONFIG_FIELDS[i].hi);
+            return;
+        }
+        next = config;
+        next.*CONFIG_FIELDS[i].field = v;
+        if (!configValid(&next)) {
+            Serial.println("cfg: repeater (role 2) needs the 2nd HC-12 on - cfg radio2 1 or 2 first.");
+            return;
+        }
+        config.*CONFIG_FIELDS[i].field = v;
+        if (!CONFIG_FIELDS[i].reboot) {
+            applyConfig();
+        }
+        Serial.printf("%s = %lu%s (cfg commit to store).\n", CONFIG_FIELDS[i].name, (unsigned long) v,
+                      (CONFIG_FIELDS[i].reboot ? ", at next boot" : ""));
+        return;
+    }
+    Serial.printf("cfg: unknown \"%s\".\n", args);
+}
+
+/**
+ * ------------------------------------------------
+ *      Commit config to NVS.
+ * ------------------------------------------------
+ *
+ * Called every loop(). Writes only when a commit is queued, the blob differs from NVS, CONFIG_MIN_WRITE_MS has
+ * passed since the last write & an inter-epoch gap has room (NVS writes are flash writes - see inEpochGap()).
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-08:00pm] New.
+ * @see    configCommand().
+ */
+void checkConfig() {
+
+    // -- Local vars. --
+    Preferences prefs;
+
+    if (!configPending) {
+        return;
+    }
+    config.crc = configCrc(&config);
+    if (memcmp(&config, &configStored, sizeof(config)) == 0) {      // Unchanged - no write.
+        configPending = false;
+        Serial.println("cfg unchanged.");
+        return;
+    }
+    if (((configWrites > 0) && (millis() - configLastWrite < CONFIG_MIN_WRITE_MS)) || !inEpochGap(UPDATE_FLASH_US)) {
+        return;
+    }
+    configPending = false;
+    flashOpBegin();
+    if (!prefs.begin(CONFIG_NAMESPACE, false) || (prefs.putBytes(CONFIG_KEY, &config, sizeof(config)) != sizeof(config))) {
+        prefs.end();
+        flashOpEnd();
+        Serial.println("cfg commit failed.");
+        return;
+    }
+    prefs.end();
+    flashOpEnd();
+    configStored    = config;
+    configLastWrite = millis();
+    configWrites++;
+    Serial.println("cfg committed.");
+}
+
+/**
+ * ------------------------------------------------
+ *      Display config.
+ * ------------------------------------------------
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-08:00pm] New.
+ * @see    configCommand().
+ */
+void showConfig() {
+    Serial.printf("\nConfig v%u from %s, read %lu us, %lu writes this boot%s:\n", (unsigned) CONFIG_VERSION,
+                  configSource, (unsigned long) configLoadUs, (unsigned long) configWrites,
+                  (configPending ? ", commit pending" : ""));
+    for (size_t i = 0; i < CONFIG_NUM_FIELDS; i++) {
+        uint32_t now    = config.*CONFIG_FIELDS[i].field;
+        uint32_t stored = configStored.*CONFIG_FIELDS[i].field;
+        Serial.printf("  %-9s %8lu", CONFIG_FIELDS[i].name, (unsigned long) now);
+        if (now != stored) {
+            Serial.printf("  (stored %lu)", (unsigned long) stored);
+        }
+        Serial.println(CONFIG_FIELDS[i].reboot ? "  [reboot]" : "");
+    }
+}
+
+/**
+ * ------------------------------------------------
+ *      Display power mode & energy estimate.
+ * ------------------------------------------------
+ *
+ * Average current = time weighted POWER_MA_RUN / POWER_MA_IDLE / POWER_MA_SLEEP (chip only; the HC-12 & ZED are not
+ * included). tools/energy_model.py runs the same model over a flight recorder dump for all modes at once.
+ *
+ * @return void No output is returned.
+ * @since  3.1.0 [2026-10-17-06:00pm] New.
+ * @see    checkSerialUSB().
+ */
+void showPower() {
+
+    // -- Local vars. --
+    int64_t total = esp_timer_get_time() - power.since;
+    int64_t run   = total - power.idleUs - power.sleepUs;
+    float   mA;
+
+    Serial.printf("\nPower mode: %s (CPU %lu MHz now), burst period %lu ms.\n", POWER_NAMES[power.mode],
+                  (unsigned long) getCpuFrequencyMhz(), (unsigned long) (power.periodUs / 1000));
+    if (total <= 0) {
+        return;
+    }
+    mA = (run * POWER_MA_RUN + power.idleUs * POWER_MA_IDLE + power.sleepUs * POWER_MA_SLEEP) / total;
+    Serial.printf("Over %lu s: run %lu%%, idle %lu%%, sleep %lu%% - est. %.1f mA (run mode %.1f mA, %.0f%% saved).\n",
+                  (unsigned long) (total / 1000000), (unsigned long) (run * 100 / total),
+                  (unsigned long) (power.idleUs * 100 / total), (unsigned long) (power.sleepUs * 100 / total), mA,
+                  POWER_MA_RUN, 100.0 * (1.0 - mA / POWER_MA_RUN));
+    if (power.sleeps > 0) {
+        Serial.printf("Light sleeps %lu, late wakes %lu, wake to burst last %ld ms, min %ld ms.\n",
+                      (unsigned long) power.sleeps, (unsigned long) power.lateWakes, (long) power.marginLast,
+                      (long) ((power.marginMin == INT32_MAX) ? 0 : power.marginMin));
+    }
+}
+
+/**
+ * Return RTCM3 message type.
+ *
+ * RTCM3 message structure:
+ *   Byte 0: Preamble (0xD3).
+ *   Byte 1-2: Reserved (6 bits) + Message length (10 bits).
+ *   Byte 3-4: Message type (12 bits) + rest of message.
+ *      - Message type starts at bit 24 (byte 3) and is 12 bits long.
+ *      - It occupies the upper 8 bits of byte 3 and upper 4 bits of byte 4.
+ *
+ * @param  array RTCM3 sentence.
+ * @return uint16_t Message type.
+ * @since  0.8.7 [2025-12-16-06:00pm] New.
+ * @since  3.1.0 [2026-10-17-09:00pm] Unsigned bytes via bitReader (bytes >= 0x80 were sign extended).
+ * @since  3.1.1 [2026-10-18-01:00am] HOT_FN (IRAM under GR_IRAM).
+ * @see    checkRTCMtoRadio().
+ * @link   https://portal.u-blox.com/s/question/0D52p0000C7MwDfCQK/can-you-find-out-the-message-type-of-a-given-rtcm3-message.
+ */
+uint16_t HOT_FN rtcm3GetMessageType(const char *buffer) {
+    bitReader r;
+    if ((uint8_t) buffer[0] != RTCM_PREAMBLE) {    // Check if preamble is correct
+        return 0;                                   // Invalid preamble.
+    }
+    bitsInit(&r, (const uint8_t *) buffer, 5, 24);
+    return bitsGet(&r, 12);
+}
+
+/**
+ * ------------------------------------------------
+ *      Toggle LEDs.
+ * ------------------------------------------------
+ *
+ * @param  char ledR Radio LED.
+ * @return void No output is returned.
+ * @since  0.3.3 [2025-05-29-10:00pm] New.
+ * @since  3.0.9 [2025-12-14-02:00pm] Version 3.
+ * @link   https://www.freertos.org/Documentation/02-Kernel/04-API-references/02-Task-control/06-vTaskSuspend.
+ * @link   https://www.freertos.org/Documentation/02-Kernel/04-API-references/02-Task-control/07-vTaskResume.
+ */
+void updateLED(char ledR) {
+
+    // --- Radio LED. ---
+    switch (ledR) {
+        case '0':
+            digitalWrite(LED_RADIO, LOW);               // LED off.
+            break;
+        case '1':
+            digitalWrite(LED_RADIO, HIGH);              // LED on.
+            break;
+        case '2':
+            vTaskResume(radioRtcmLEDtaskHandle);        // Resume task.
+            break;
+    }
+}
+
+// --- Test. ---
+
+/**
+ * ============================================================================
+ *                          Setup.
+ * ============================================================================
+ *
+ * Radio path first: vars & pins (HC-12 SET high) take microseconds, then the ZED & HC-12 UARTs. The banner is
+ * deferred to loop() (checkBootBanner()).
+ *
+ * @return void  No output is returned.
+ * @since  3.0.9 [2025-12-14-02:00pm] New.
+ * @since  3.1.0 [2026-10-17-11:00am] Radio path first, banner deferred.
+ */
+void setup() {
+    bootTime[BOOT_SETUP] = esp_timer_get_time();    // Boot timeline.
+    initVars();                         // Initialize global vars.
+    loadConfig();                       // Settings from NVS (one read).
+    initPins();                         // Initialize pins & pin values.
+    startSerial();                      // Start serial interfaces.
     startTasks();                       // Start tasks.
     startLoop();                        // On to loop().
 }
@@ -811,6 +7080,7 @@ void setup() {
  * ============================================================================
  * @see startTasks()              - Start tasks.
  *   @see radioRtcmLEDtask()      - Radio active LED.
+ *   @see taskMonitorTask()       - Task CPU & stack sampler.
  */
 
 /**
@@ -820,8 +7090,36 @@ void setup() {
  *
  * @return void No output is returned.
  * @since  3.0.9 [2025-12-14-02:00pm] New.
+ * @since  3.1.0 [2026-10-17-06:00pm] Power mode.
+ * @since  3.1.0 [2026-10-17-07:00pm] Firmware update.
+ * @since  3.1.0 [2026-10-17-08:00pm] Config commit.
+ * @since  3.1.0 [2026-10-17-11:00pm] Watchdog.
  */
 void loop() {
-    checkSerialUSB();                   // Check serial USB for input.
+    loopCount++;                        // Count loop() passes (task monitor).
+    hotPass();                          // Pass time vs flash ops.
+    checkBootBanner();                  // Deferred banner & boot timeline.
+    if (update.stage == UPDATE_IDLE) {
+        checkSerialUSB();               // Check serial USB for input.
+    } else {
+        checkUpdate();                  // USB input is firmware image.
+    }
+    if (role != ROLE_RELAY) {
+        checkRadioToGnss();             // Check Serial1 for input (HC-12), validated RTCM3 to the GNSS / repeated.
+        checkConfig();                  // Coalesced config commit.
+        return;
+    }
+    if (selfTest.mode != ST_OFF) {
+        checkSelfTest();                // Throughput self test steps (relay input is the generator).
+        checkRTCMtoRadio();
+        checkFrameDone();
+        return;
+    }
     checkRTCMtoRadio();                 // Check Serial0 for input (EVK RTCM), relay to Serial1 (HC-12 radio).
+    checkFrameDone();                   // Frame done: epoch planning, profile, LED (flash side of rtcmFrameDone()).
+    checkTelemetry();                   // Inject relay telemetry into idle airtime.
+    checkPower();                       // Idle or sleep in the inter-epoch gap.
+    checkConfig();                      // Coalesced config commit.
+    checkWatchdog();                    // Input stall & Serial1 TX stall.
+    checkBaud();                        // ZED speed scan, or rescan on a garbage stream.
 }
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""
+Ghost Rover 3 - RTCM relay power mode energy model.
+
+Replays real frame timing through the relay's power modes (see checkPower() in the sketch) and reports the
+estimated average ESP32-C6 current, the saving against "run" and the wake latency each mode adds.
+
+Timing comes from a flight recorder dump: type "rec" on the USB console and save the output. Each frame line gives
+arrival (ms), length and modelled on-air time. Without a dump, --synthetic BYTES models 1 Hz bursts of BYTES.
+
+Usage:
+    energy_model.py rec_dump.txt [--guard 20] [--gap 60] [--battery 2000]
+    energy_model.py --synthetic 900 [--seconds 600]
+
+Model (same constants as the sketch's power section):
+    run    busy poll at 160 MHz all the time.
+    idle   after input is quiet for --gap ms & the HC-12 has drained, 80 MHz + WFI until the next byte.
+           Adds <= 1 ms (one tick) before the first byte is read; no bytes are lost (UART keeps running).
+    sleep  as idle, but light sleep until --guard ms before the predicted burst. A burst that starts inside the
+           guard-less sleep wakes on RTCM_IN & loses its first bytes (late wake).
+
+@since 3.1.0 [2026-10-17-06:00pm] New.
+"""
+
+import argparse
+import re
+import sys
+
+SERIAL0_SPEED = 57600               # ZED -> relay (bps, 8N1).
+MA_RUN = 30.0                       # 160 MHz busy (mA).
+MA_IDLE = 12.0                      # 80 MHz, mostly WFI (mA).
+MA_SLEEP = 0.25                     # Light sleep (mA).
+MIN_SLEEP_MS = 10.0                 # Shorter sleeps are skipped.
+WAKE_MS = 1.0                       # Light sleep exit + CPU clock restore (ms, approx.).
+
+REC_LINE = re.compile(r"^\s*\d+\s+(\d+)\s+(\d+)\s+(\d+)\s+(ok|BAD)\s+(\w+)\s+(\d+)\s*$")
+
+
+def load_dump(path):
+    """(arrival_ms, end_ms) per frame from a "rec" console dump, end = max(last byte in, on air done)."""
+    frames = []
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            m = REC_LINE.match(line)
+            if not m:
+                continue
+            arrival, length, air = int(m.group(1)), int(m.group(3)), int(m.group(6))
+            wire = (length + 6) * 10 * 1000.0 / SERIAL0_SPEED
+            frames.append((arrival, arrival + max(wire, air)))
+    frames.sort()
+    return frames
+
+
+def synthetic(burst_bytes, seconds):
+    """1 Hz epochs: a burst of ~200 byte frames, back to back at SERIAL0_SPEED."""
+    frames = []
+    for s in range(seconds):
+        t = s * 1000.0 + 30.0
+        left = burst_bytes
+        while left > 0:
+            size = min(200, left)
+            wire = size * 10 * 1000.0 / SERIAL0_SPEED
+            frames.append((t, t + wire + size * 10 * 1000.0 / 9600))
+            t += wire
+            left -= size
+    return frames
+
+
+def bursts(frames, gap_ms):
+    """Group frames into (start_ms, busy_until_ms) bursts split by input quiet >= gap_ms."""
+    out = []
+    for arrival, end in frames:
+        if out and arrival - out[-1][2] < gap_ms:
+            out[-1][1] = max(out[-1][1], end)
+            out[-1][2] = arrival
+        else:
+            out.append([arrival, end, arrival])
+    return [(start, busy) for start, busy, _ in out]
+
+
+def model(burst_list, mode, gap_ms, guard_ms):
+    """Time weighted average mA, worst added wake latency (ms) & late wakes for one power mode."""
+    if len(burst_list) < 2:
+        raise SystemExit("need at least two bursts")
+    total = burst_list[-1][0] - burst_list[0][0]
+    run = idle = sleep = 0.0
+    late = 0
+    latency = 0.0
+    period = 0.0
+    for i in range(len(burst_list) - 1):
+        start, busy = burst_list[i]
+        nxt = burst_list[i + 1][0]
+        if i > 0:
+            delta = start - burst_list[i - 1][0]
+            period = delta if period == 0 else period + (delta - period) / 4
+        awake_until = min(busy + gap_ms, nxt)
+        run += awake_until - start
+        rest = nxt - awake_until
+        if mode == "run":
+            run += rest
+        elif mode == "idle":
+            idle += rest
+            latency = max(latency, 1.0)
+        else:
+            wake = start + period - guard_ms if period else awake_until
+            if period and wake - awake_until >= MIN_SLEEP_MS:
+                if nxt < wake:                                      # Burst came inside the sleep - late wake.
+                    late += 1
+                    sleep += nxt - awake_until
+                    latency = max(latency, WAKE_MS)
+                else:
+                    sleep += wake - awake_until
+                    idle += nxt - wake
+            else:
+                idle += rest
+    ma = (run * MA_RUN + idle * MA_IDLE + sleep * MA_SLEEP) / total
+    return ma, latency, late, (run / total, idle / total, sleep / total)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1].strip())
+    parser.add_argument("path", nargs="?", help="flight recorder dump (\"rec\" console output)")
+    parser.add_argument("--synthetic", type=int, metavar="BYTES", help="model 1 Hz bursts of BYTES instead")
+    parser.add_argument("--seconds", type=int, default=600, help="synthetic duration (default 600)")
+    parser.add_argument("--gap", type=float, default=60.0, help="quiet before the gap starts (ms, default 60)")
+    parser.add_argument("--guard", type=float, default=20.0, help="sleep wake ahead of burst (ms, default 20)")
+    parser.add_argument("--battery", type=float, default=0.0, help="battery capacity (mAh) for a runtime estimate")
+    args = parser.parse_args()
+
+    if args.synthetic:
+        frames = synthetic(args.synthetic, args.seconds)
+    elif args.path:
+        frames = load_dump(args.path)
+    else:
+        parser.error("give a dump file or --synthetic BYTES")
+    burst_list = bursts(frames, args.gap)
+    span = (burst_list[-1][0] - burst_list[0][0]) / 1000.0 if burst_list else 0.0
+    print(f"{len(frames)} frames, {len(burst_list)} bursts over {span:.0f} s.")
+    base = None
+    for mode in ("run", "idle", "sleep"):
+        ma, latency, late, (r, i, s) = model(burst_list, mode, args.gap, args.guard)
+        base = base or ma
+        life = f", {args.battery / ma:.0f} h on {args.battery:.0f} mAh" if args.battery else ""
+        print(f"  {mode:<5} {ma:6.2f} mA ({100 * (1 - ma / base):3.0f}% saved) run {100 * r:3.0f}% idle {100 * i:3.0f}% "
+              f"sleep {100 * s:3.0f}%, wake latency <= {latency:.1f} ms, late wakes {late}{life}")
+    print("Chip only - HC-12 & ZED current not included.")
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        sys.exit(0)
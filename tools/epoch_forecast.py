@@ -0,0 +1,298 @@
+#!/usr/bin/env python3
+"""
+Ghost Rover 3 - RTCM relay epoch forecast replay.
+
+Replays an RTCM3 capture through the relay's decimation (decimEpochDone() in the sketch): reactive (ratios adapt
+one step after each epoch, from byte averages, as the relay does) and a predictive plan fixed at each epoch's first
+MSM that drops low priority constellations forecast over the budget - forecast from the previous epoch's satellite /
+signal / cell masks (fcastStart()) or from the averages. Reports the forecast error of masks & averages, and epoch
+to air latency with the MSM bytes each run delivered. A plan that drops bytes always looks faster, so reactive is
+also rerun with a lower budget until it delivers no more than the masks plan: compare latency at equal bytes.
+
+On --synthetic 600 the masks forecast is no better than the averages (|err| 29.6 vs 29.5 bytes/epoch, bias -7.3 vs
++4.3) and the masks plan's 17.6 ms gain over reactive comes from 9567 fewer bytes: at equal bytes it is +0.3 ms
+(seed 2: reactive 40.9 ms better). The relay therefore only scores the forecast ("fcast") & does not plan on it.
+
+Usage:
+    epoch_forecast.py capture.rtcm [--period 1000] [--zed 57600] [--radio 9600] [--hop]
+    epoch_forecast.py --synthetic 600 [--seed 1]
+
+Model (same constants as the sketch's decimation section):
+    Epochs start every --period ms; frames arrive back to back at --zed bps & cut through to one HC-12 at
+    --radio bps (10 bits per byte). Epoch latency = last relayed MSM byte on air - first MSM byte in.
+    --synthetic N makes N epochs of GPS, GLONASS, Galileo & BeiDou MSM7 (2 signals, satellites rising & setting)
+    plus 1005 every 10 epochs, when there is no capture to hand.
+
+@since 3.1.1 [2026-10-18-04:00am] New.
+@since 3.1.1 [2026-10-18-06:30am] Averages plan & equal bytes comparison; epoch terminator always relayed.
+"""
+
+import argparse
+import random
+import sys
+
+from rtcm_telemetry import frames, get_bits, source
+
+DECIM_PRIORITY = [0, 2, 5, 1, 4, 3, 6]
+DECIM_MAX_RATIO = 4
+DECIM_CYCLE = 12
+DECIM_BUDGET_PCT = 90
+DECIM_RELAX_PCT = 80
+MSM_HEADER_BITS = 169
+MSM_SAT_BITS = [10, 10, 10, 18, 36, 18, 36]
+MSM_CELL_BITS = [15, 27, 42, 48, 63, 65, 80]
+DECIDE_AT = 10
+
+
+def msm_gnss(msg):
+    """MSM constellation index, or -1."""
+    if 1071 <= msg <= 1137 and 1 <= msg % 10 <= 7:
+        return (msg - 1071) // 10
+    return -1
+
+
+def air_len(payload_len, hop):
+    """Frame bytes on air."""
+    return payload_len + ((1 if payload_len < 0x80 else 2) + 2 if hop else 6)
+
+
+def masks(payload):
+    """(satellites, cell mask bits, cells) of an MSM payload."""
+    sats = bin(get_bits(payload, 73, 64)).count("1")
+    sigs = bin(get_bits(payload, 137, 32)).count("1")
+    mask_bits = min(sats * sigs, 64)
+    return sats, mask_bits, bin(get_bits(payload, MSM_HEADER_BITS, mask_bits)).count("1")
+
+
+def mask_bytes(msg, count, sats, mask_bits, cells, hop):
+    """Air bytes of a constellation's MSMs from its masks (fcastBytes())."""
+    if not count:
+        return 0
+    level = msg % 10 - 1
+    bits = count * MSM_HEADER_BITS + mask_bits + sats * MSM_SAT_BITS[level] + cells * MSM_CELL_BITS[level]
+    return count * air_len((bits + 7 * count) // 8 // count, hop)
+
+
+def epochs(payloads, hop):
+    """Group CRC-valid frames into epochs: list of (msg, air bytes, gnss, masks) per epoch."""
+    epoch = []
+    for payload in payloads:
+        msg = get_bits(payload, 0, 12)
+        gnss = msm_gnss(msg)
+        epoch.append((msg, air_len(len(payload), hop), gnss, masks(payload) if gnss >= 0 else None))
+        if gnss >= 0 and not get_bits(payload, 54, 1):        # Multiple message bit clear - epoch done.
+            yield epoch
+            epoch = []
+
+
+def ema(avg, value):
+    """The sketch's integer EMA: avg += (value - avg) / 4, truncated toward zero."""
+    return avg + int((value - avg) / 4)
+
+
+def put_bits(bits, value, length):
+    bits.extend((value >> (length - 1 - i)) & 1 for i in range(length))
+
+
+def synthetic(count, seed):
+    """Payloads of count epochs: 4 constellations of MSM7 (2 signals), 1005 every 10 epochs."""
+    rng = random.Random(seed)
+    visible = {0: 9, 1: 7, 2: 8, 5: 10}
+    for n in range(count):
+        if n % 10 == 0:
+            yield bytes([0x3E, 0xD0]) + bytes(17)               # 1005, 19 bytes.
+        order = sorted(visible)
+        for i, gnss in enumerate(order):
+            if rng.random() < 0.03:                             # A satellite rises or sets.
+                visible[gnss] = max(4, min(14, visible[gnss] + rng.choice((-1, 1))))
+            sats = visible[gnss]
+            bits = []
+            put_bits(bits, 1077 + 10 * gnss, 12)
+            put_bits(bits, 1, 12)
+            put_bits(bits, n * 1000, 30)
+            put_bits(bits, 1 if i < len(order) - 1 else 0, 1)
+            put_bits(bits, 0, 18)                               # IODS to smoothing interval.
+            put_bits(bits, (1 << 64) - (1 << (64 - sats)), 64)
+            put_bits(bits, 0xC0000000, 32)
+            cells = [1 if rng.random() < 0.9 else 0 for _ in range(2 * sats)]
+            bits.extend(cells)
+            bits.extend([0] * (sats * MSM_SAT_BITS[6] + sum(cells) * MSM_CELL_BITS[6]))
+            bits.extend([0] * (-len(bits) % 8))
+            yield bytes(int("".join(map(str, bits[i:i + 8])), 2) for i in range(0, len(bits), 8))
+
+
+class Decimation:
+    """The relay's decimation (decimEpochDone(), decimPhases()), optionally with the forecast plan."""
+
+    def __init__(self, capacity, period, hop, predictive, forecaster="masks", budget_pct=DECIM_BUDGET_PCT):
+        self.capacity = capacity * period // 1000 * budget_pct // 100
+        self.hop = hop
+        self.predictive = predictive
+        self.forecaster = forecaster
+        self.epoch = 0
+        self.avg = [0] * 7
+        self.avg_other = 0
+        self.ratio = [1] * 7
+        self.phase = [0] * 7
+        self.budget = self.capacity
+        self.last = {}                                          # gnss -> (msg, frames, sats, mask bits, cells).
+        self.skip = set()
+
+    def due(self, c):
+        return (self.epoch + self.phase[c]) % self.ratio[c] == 0
+
+    def plan(self, first_gnss, first_len):
+        """Forecast & plan at the first MSM (fcastPlan())."""
+        predicted = [mask_bytes(*self.last[c], self.hop) if c in self.last else 0 for c in range(7)]
+        if any(predicted):
+            predicted[first_gnss] = max(predicted[first_gnss], first_len)
+        else:
+            predicted = list(self.avg)
+        masks_total = self.avg_other + sum(predicted)
+        if self.forecaster == "averages":
+            predicted = list(self.avg)
+        self.skip = set()
+        load = sum(predicted[c] for c in range(7) if self.due(c))
+        keep = next((c for c in DECIM_PRIORITY if self.due(c) and predicted[c]), None)
+        if self.predictive:
+            for c in reversed(DECIM_PRIORITY):
+                if load <= self.budget:
+                    break
+                if c != keep and predicted[c] and self.due(c):
+                    self.skip.add(c)
+                    load -= predicted[c]
+        return masks_total, self.avg_other + sum(self.avg)
+
+    def sent(self, c):
+        return self.due(c) and c not in self.skip
+
+    def done(self, demand, other, seen):
+        """Epoch done: fold averages, adapt one ratio (decimEpochDone())."""
+        self.last = seen
+        load = 0
+        for c in range(7):
+            self.avg[c] = ema(self.avg[c], demand[c])
+            load += self.avg[c] // self.ratio[c]
+        self.avg_other = ema(self.avg_other, other)
+        self.budget = max(self.capacity - self.avg_other, 0)
+        if load > self.budget:
+            for c in reversed(DECIM_PRIORITY):
+                if self.avg[c] and self.ratio[c] < DECIM_MAX_RATIO:
+                    self.ratio[c] += 1
+                    self.phases()
+                    return
+        else:
+            for c in DECIM_PRIORITY:
+                if self.ratio[c] > 1:
+                    load += self.avg[c] // (self.ratio[c] - 1) - self.avg[c] // self.ratio[c]
+                    if load * 100 <= self.budget * DECIM_RELAX_PCT:
+                        self.ratio[c] -= 1
+                        self.phases()
+                    return
+
+    def phases(self):
+        slot = [sum(self.avg[c] for c in range(7) if self.ratio[c] == 1)] * DECIM_CYCLE
+        for c in sorted((c for c in range(7) if self.ratio[c] > 1), key=lambda c: -self.avg[c]):
+            best = min(range(self.ratio[c]), key=lambda p: max(
+                slot[s] + (self.avg[c] if (s + p) % self.ratio[c] == 0 else 0) for s in range(DECIM_CYCLE)))
+            self.phase[c] = best
+            slot = [slot[s] + (self.avg[c] if (s + best) % self.ratio[c] == 0 else 0) for s in range(DECIM_CYCLE)]
+
+
+def replay(epoch_list, args, predictive, forecaster="masks", budget_pct=DECIM_BUDGET_PCT):
+    """Run all epochs; return (latencies ms, forecast errors, baseline errors, skipped bytes, MSM bytes sent)."""
+    zed_ms = 10000 / args.zed
+    radio_ms = 10000 / args.radio
+    d = Decimation(args.radio // 10, args.period, args.hop, predictive, forecaster, budget_pct)
+    radio_free = 0.0
+    latencies, errors, base_errors = [], [], []
+    skipped = sent_bytes = 0
+    for n, epoch in enumerate(epoch_list):
+        t = n * args.period
+        d.epoch += 1
+        first = next(i for i, f in enumerate(epoch) if f[2] >= 0)
+        forecast, baseline = d.plan(epoch[first][2], epoch[first][1])
+        demand, seen, other = [0] * 7, {}, 0
+        start, last_air = None, None
+        for i, (msg, length, gnss, mask) in enumerate(epoch):
+            arrive = t + DECIDE_AT * zed_ms
+            t += length * zed_ms
+            if gnss < 0:
+                other += length
+                relay = True
+            else:
+                start = arrive - DECIDE_AT * zed_ms if start is None else start
+                demand[gnss] += length
+                prev = seen.get(gnss, (msg, 0, 0, 0, 0))
+                seen[gnss] = (msg, prev[1] + 1, prev[2] + mask[0], prev[3] + mask[1], prev[4] + mask[2])
+                relay = d.sent(gnss) or i == len(epoch) - 1     # Epoch terminator always relayed (rtcmDecide()).
+                if not relay and gnss in d.skip:
+                    skipped += length
+            if relay:
+                radio_free = max(radio_free, arrive) + length * radio_ms
+                if gnss >= 0:
+                    last_air = radio_free
+                    sent_bytes += length
+        actual = sum(demand) + other
+        errors.append(actual - forecast)
+        base_errors.append(actual - baseline)
+        if last_air is not None:
+            latencies.append(last_air - start)
+        d.done(demand, other, seen)
+    return latencies, errors, base_errors, skipped, sent_bytes
+
+
+def summary(values):
+    values = sorted(values)
+    return (f"mean {sum(values) / len(values):7.1f}  p95 {values[int(0.95 * (len(values) - 1))]:7.1f}  "
+            f"max {values[-1]:7.1f}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1].strip())
+    parser.add_argument("path", nargs="?", help="RTCM3 capture")
+    parser.add_argument("--synthetic", type=int, metavar="EPOCHS", help="synthetic MSM7 epochs instead of a capture")
+    parser.add_argument("--seed", type=int, default=1, help="synthetic random seed")
+    parser.add_argument("--period", type=int, default=1000, help="epoch period (ms, default 1000)")
+    parser.add_argument("--zed", type=int, default=57600, help="ZED -> relay speed (bps, default 57600)")
+    parser.add_argument("--radio", type=int, default=9600, help="HC-12 speed (bps, default 9600)")
+    parser.add_argument("--hop", action="store_true", help="compact radio hop (cfg hop 1)")
+    args = parser.parse_args()
+
+    if args.synthetic:
+        payloads = synthetic(args.synthetic, args.seed)
+    elif args.path:
+        payloads = (p for p, ok in frames(source(args.path, 0)) if ok)
+    else:
+        parser.error("capture path or --synthetic EPOCHS")
+    epoch_list = [e for e in epochs(payloads, args.hop) if any(f[2] >= 0 for f in e)]
+    if len(epoch_list) < 2:
+        sys.exit("fewer than 2 MSM epochs")
+
+    reactive = replay(epoch_list, args, False)
+    masks_plan = replay(epoch_list, args, True, "masks")
+    avg_plan = replay(epoch_list, args, True, "averages")
+    pct = DECIM_BUDGET_PCT                                      # Reactive budget cut until it sends no more.
+    equal = reactive
+    while pct > 10 and equal[4] > masks_plan[4]:
+        pct -= 1
+        equal = replay(epoch_list, args, False, budget_pct=pct)
+    actual = sum(sum(f[1] for f in e) for e in epoch_list) / len(epoch_list)
+    print(f"{len(epoch_list)} epochs, {actual:.0f} air bytes/epoch, radio {args.radio // 10 * args.period // 1000} "
+          f"bytes/epoch.")
+    print("Forecast error (bytes/epoch, actual - forecast):")
+    for name, errors in (("masks", masks_plan[1]), ("averages", masks_plan[2])):
+        print(f"  {name:9s} |err| {summary([abs(e) for e in errors])}  bias {sum(errors) / len(errors):+.1f}")
+    print("Epoch to air latency (ms) & MSM bytes delivered:")
+    for name, run in (("reactive", reactive), ("plan, masks", masks_plan), ("plan, averages", avg_plan),
+                      (f"reactive {pct}%", equal)):
+        print(f"  {name:15s} {summary(run[0])}  sent {run[4]}, dropped by plan {run[3]}")
+    mean = [sum(run[0]) / len(run[0]) for run in (reactive, masks_plan, avg_plan, equal)]
+    print(f"Plan vs reactive: {mean[0] - mean[1]:+.1f} ms/epoch for {reactive[4] - masks_plan[4]} fewer bytes. "
+          f"At equal bytes (reactive budget {pct}%): {mean[3] - mean[1]:+.1f} ms. "
+          f"Masks vs averages forecast in the plan: {mean[2] - mean[1]:+.1f} ms, "
+          f"{masks_plan[4] - avg_plan[4]:+d} bytes.")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,285 @@
+#!/usr/bin/env python3
+"""
+Ghost Rover 3 - RTCM relay USB binary protocol client (library & CLI).
+
+Talks to the COBS framed binary protocol that shares the relay's USB console with the text commands (see binByte()
+& binRequest() in the sketch). Text the relay prints meanwhile is passed through (or collected), never mistaken
+for a response.
+
+Usage:
+    relay_client.py /dev/ttyACM0 info | stats | latency | timestamps | wdog | tasks | cfg
+    relay_client.py /dev/ttyACM0 set hop 1          # Config field (applied now unless reboot-only).
+    relay_client.py /dev/ttyACM0 commit | defaults
+    relay_client.py /dev/ttyACM0 cmd "lat"          # Allow-listed show commands, no arguments (BIN_CMD_ALLOWED); text.
+    relay_client.py /dev/ttyACM0 poll [--rate 10] [--seconds 60]
+
+"poll" reads stats & latency at --rate Hz and reports round trip times, the relay's own handling time per request
+and epoch to air latency, so the impact of polling can be checked against a run without it.
+
+Library:
+    from relay_client import Relay
+    with Relay("/dev/ttyACM0") as relay:
+        print(relay.stats()["framesOut"])
+
+Frame: 0x00, COBS([op][seq][args]), 0x00. Response: 0x00, COBS([op | 0x80][seq][status][data]), 0x00. Little endian.
+
+@since 3.1.0 [2026-10-17-11:59pm] New.
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+BIN_INFO, BIN_STATS, BIN_LATENCY, BIN_WDOG, BIN_TASKS, BIN_CFG_GET, BIN_CFG_SET, BIN_CMD = range(1, 9)
+STATUS = {0: "ok", 1: "bad op", 2: "bad argument", 3: "busy"}
+GNSS_NAMES = ["GPS", "GLO", "GAL", "SBAS", "QZSS", "BDS", "NavIC"]
+POWER_NAMES = ["run", "idle", "sleep"]
+COUNTERS = ["bytesIn", "framesIn", "crcErrors", "framesOut", "resyncs", "rxOverflows", "telemetryOut", "decimated",
+            "uptime"]
+
+
+def cobs_encode(data):
+    """COBS encode (no delimiter)."""
+    out = bytearray([0])
+    code = 0
+    for b in data:
+        if b == 0:
+            out[code] = len(out) - code
+            code = len(out)
+            out.append(0)
+        else:
+            out.append(b)
+            if len(out) - code == 0xFF:
+                out[code] = 0xFF
+                code = len(out)
+                out.append(0)
+    out[code] = len(out) - code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    """COBS decode (no delimiter). Raises ValueError if malformed."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            raise ValueError("bad COBS")
+        out.extend(data[i:i + code - 1])
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class RelayError(Exception):
+    """Request failed (status or timeout)."""
+
+
+class Relay:
+    """Binary protocol session on a relay USB port."""
+
+    def __init__(self, port, baud=115200, timeout=1.0, text=None):
+        import serial                                           # pyserial.
+        self.port = serial.Serial(port, baud, timeout=0.02)
+        self.timeout = timeout
+        self.text = text if text is not None else (lambda line: print(f"  relay: {line}"))
+        self.seq = 0
+        self.buf = bytearray()
+        self.line = bytearray()
+        self.frames = []
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.port.close()
+
+    def _pump(self):
+        """Read what is there; split text lines from 0x00 delimited frames."""
+        self.buf.extend(self.port.read(max(1, self.port.in_waiting)))
+        while self.buf:
+            if self.buf[0] == 0:                                # Frame start.
+                end = self.buf.find(0, 1)
+                if end < 0:
+                    return
+                if end == 1:                                    # 0x00 0x00 - resync.
+                    del self.buf[:1]
+                    continue
+                try:
+                    self.frames.append(cobs_decode(bytes(self.buf[1:end])))
+                except ValueError:
+                    pass
+                del self.buf[:end + 1]
+                continue
+            b = self.buf.pop(0)
+            if b in (0x0A, 0x0D):
+                if self.line:
+                    self.text(self.line.decode("utf-8", errors="replace"))
+                    self.line.clear()
+            else:
+                self.line.append(b)
+
+    def request(self, op, args=b""):
+        """Send one request; return the response data. Raises RelayError."""
+        self.seq = (self.seq + 1) & 0xFF
+        self.port.write(b"\x00" + cobs_encode(bytes([op, self.seq]) + args) + b"\x00")
+        end = time.time() + self.timeout
+        while time.time() < end:
+            self._pump()
+            while self.frames:
+                frame = self.frames.pop(0)
+                if len(frame) >= 3 and frame[0] == op | 0x80 and frame[1] == self.seq:
+                    if frame[2] != 0:
+                        raise RelayError(f"op {op}: {STATUS.get(frame[2], frame[2])}")
+                    return frame[3:]
+        raise RelayError(f"op {op}: no response (relay busy updating, or response dropped)")
+
+    def info(self):
+        data = self.request(BIN_INFO)
+        keys = ["version", "uptimeMs", "loops", "requests", "lastUs", "maxUs", "dropped", "errors"]
+        result = dict(zip(keys, struct.unpack_from("<8I", data)))
+        result["debug"], result["radio2"] = data[32], data[33]
+        result["build"] = data[34:].decode(errors="replace")
+        return result
+
+    def stats(self):
+        data = self.request(BIN_STATS)
+        result = dict(zip(COUNTERS, struct.unpack_from("<9I", data)))
+        result["epoch"], result["periodMs"], result["budget"] = struct.unpack_from("<3I", data, 36)
+        result["ratio"] = dict(zip(GNSS_NAMES, data[48:55]))
+        (result["link1Bytes"], result["link2Bytes"], result["hopSaved"], result["hopSavedEpoch"],
+         result["rxReinits"], result["txReinits"]) = struct.unpack_from("<6I", data, 55)
+        result["stalled"], power = data[79], data[80]
+        result["power"] = POWER_NAMES[power] if power < len(POWER_NAMES) else power
+        result["rxHighWater"], = struct.unpack_from("<H", data, 81)
+        return result
+
+    def latency(self):
+        data = self.request(BIN_LATENCY)
+        result = {}
+        for i in range(data[0]):
+            n, last_in, last, avg, lo, hi = struct.unpack_from("<I5i", data, 1 + 24 * i)
+            if n:
+                result[GNSS_NAMES[i]] = {"n": n, "lastIn": last_in, "last": last, "avg": avg, "min": lo, "max": hi}
+        return result
+
+    def timestamps(self):
+        """Serial0 arrival timestamp quality (us): error bound, UART event jitter, loop() read lag."""
+        data = self.request(BIN_LATENCY)
+        keys = ["boundUs", "jitterMaxUs", "lagAvgUs", "lagMaxUs", "noMark"]
+        return dict(zip(keys, struct.unpack_from("<5I", data, 1 + 24 * data[0])))
+
+    def wdog(self):
+        data = self.request(BIN_WDOG)
+        n = data[0]
+        limits = struct.unpack_from(f"<{n}I", data, 1)
+        detect = struct.unpack_from(f"<{n}I", data, 1 + 4 * n)
+        recover = struct.unpack_from(f"<{n}I", data, 1 + 8 * n)
+        last_detect, last_recover = struct.unpack_from("<2I", data, 1 + 12 * n)
+        return {"limits": limits, "detect": detect, "recover": recover, "lastDetect": last_detect,
+                "lastRecover": last_recover}
+
+    def tasks(self):
+        data = self.request(BIN_TASKS)
+        samples = data[0]
+        rate, rate_min = struct.unpack_from("<2I", data, 1)
+        tasks = []
+        for i in range(data[9]):
+            name, cpu, peak, stack = struct.unpack_from("<12s2HI", data, 10 + 20 * i)
+            tasks.append({"name": name.split(b"\0")[0].decode(), "cpu": cpu / 10, "peak": peak / 10, "stack": stack})
+        return {"samples": samples, "loopRate": rate, "loopRateMin": rate_min, "tasks": tasks}
+
+    def cfg(self):
+        data = self.request(BIN_CFG_GET)
+        fields = []
+        for i in range(data[1]):
+            name, value, lo, hi, flags = struct.unpack_from("<9s3IB", data, 2 + 22 * i)
+            fields.append({"name": name.split(b"\0")[0].decode(), "value": value, "lo": lo, "hi": hi,
+                           "reboot": bool(flags & 1), "unsaved": bool(flags & 2)})
+        return {"pending": bool(data[0]), "fields": fields}
+
+    def set(self, name, value):
+        names = [f["name"] for f in self.cfg()["fields"]]
+        if name not in names:
+            raise RelayError(f"unknown config field {name} ({', '.join(names)})")
+        self.request(BIN_CFG_SET, struct.pack("<BI", names.index(name), value))
+
+    def commit(self):
+        self.request(BIN_CFG_SET, b"\xfe")
+
+    def defaults(self):
+        self.request(BIN_CFG_SET, b"\xff")
+
+    def command(self, text):
+        self.request(BIN_CMD, text.encode())
+
+
+def poll(relay, rate, seconds):
+    """Poll stats & latency at rate Hz; report round trip & relay handling time."""
+    period = 1.0 / rate
+    rtt = []
+    start = time.time()
+    before = relay.info()
+    next_at = start
+    while time.time() - start < seconds:
+        t = time.time()
+        stats = relay.stats()
+        latency = relay.latency()
+        rtt.append((time.time() - t) * 1000 / 2)
+        lat = " ".join(f"{k} {v['avg']}" for k, v in latency.items())
+        print(f"\r  out {stats['framesOut']} decim {stats['decimated']} epoch {stats['epoch']} latency avg ms: {lat}   ",
+              end="", flush=True)
+        next_at += period
+        time.sleep(max(0.0, next_at - time.time()))
+    print()
+    after = relay.info()
+    rtt.sort()
+    requests = after["requests"] - before["requests"]
+    print(f"{requests} requests in {seconds} s. Round trip ms: median {rtt[len(rtt) // 2]:.1f}, "
+          f"max {rtt[-1]:.1f}. Relay handling: max {after['maxUs']} us, "
+          f"dropped {after['dropped'] - before['dropped']}.")
+    print(f"Relay CPU for polling ~ {requests * after['maxUs'] / (seconds * 1e6) * 100:.3f}% (upper bound).")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1].strip())
+    parser.add_argument("port", help="relay USB serial port")
+    parser.add_argument("what", choices=["info", "stats", "latency", "timestamps", "wdog", "tasks", "cfg", "set",
+                                         "commit", "defaults", "cmd", "poll"])
+    parser.add_argument("args", nargs="*", help="set: NAME VALUE, cmd: TEXT")
+    parser.add_argument("--rate", type=float, default=10.0, help="poll rate (Hz, default 10)")
+    parser.add_argument("--seconds", type=float, default=60.0, help="poll duration (s, default 60)")
+    args = parser.parse_args()
+
+    with Relay(args.port) as relay:
+        try:
+            if args.what == "poll":
+                poll(relay, args.rate, args.seconds)
+            elif args.what == "set":
+                if len(args.args) != 2:
+                    parser.error("set NAME VALUE")
+                relay.set(args.args[0], int(args.args[1]))
+            elif args.what == "cmd":
+                relay.command(" ".join(args.args))
+                end = time.time() + 1.0                         # Show the command's text output.
+                while time.time() < end:
+                    relay._pump()
+            elif args.what in ("commit", "defaults"):
+                getattr(relay, args.what)()
+            else:
+                result = getattr(relay, args.what)()
+                if isinstance(result, dict):
+                    for key, value in result.items():
+                        print(f"{key}: {value}")
+        except RelayError as err:
+            sys.exit(str(err))
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        sys.exit(130)
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+Ghost Rover 3 - RTCM relay compact radio hop encoder / decoder.
+
+With "cfg hop 1" the relay sends each RTCM3 frame as [length][payload][CRC-16] instead of
+[0xD3 000000 length(10)][payload][CRC-24Q] (see hopHeader() in the sketch). This tool:
+
+  - reports what the compact hop saves, per frame type & per epoch, on an RTCM3 capture, and checks that every
+    CRC-valid frame survives encode -> decode bit-exactly;
+  - rebuilds standard RTCM3 from a compact stream (rover side HC-12 serial port or a capture), for the rover's
+    GNSS or for rtcm_telemetry.py.
+
+Usage:
+    rtcm_hop.py capture.rtcm                                    # Saving report & round trip check.
+    rtcm_hop.py --decode /dev/ttyUSB0 [--baud 9600] --out -     # Compact stream -> RTCM3 on stdout.
+    rtcm_hop.py --decode hop_capture.bin --out rebuilt.rtcm
+
+Compact frame: length = payload bytes, 1 byte if < 128, else 2 (low 7 bits | 0x80, then high 3 bits), then the
+payload, then CRC-16/CCITT (init 0xFFFF, big endian) over length & payload. A frame whose CRC-24Q failed at the relay
+is sent with the CRC-16 inverted, so it is dropped here. There is no preamble: the decoder resyncs at a quiet gap
+on the serial port (the inter-epoch gap) or by hunting for a CRC-16 valid frame with a known message type.
+
+@since 3.1.0 [2026-10-17-11:30pm] New.
+"""
+
+import argparse
+import collections
+import os
+import sys
+
+from rtcm_telemetry import crc24q, frames, get_bits, source
+
+PREAMBLE = 0xD3
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT (polynomial 0x1021) over bytes."""
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+        crc &= 0xFFFF
+    return crc
+
+
+def encode(payload):
+    """Compact hop frame for an RTCM3 payload."""
+    n = len(payload)
+    head = bytes([n]) if n < 0x80 else bytes([(n & 0x7F) | 0x80, n >> 7])
+    body = head + payload
+    return body + crc16(body).to_bytes(2, "big")
+
+
+def rebuild(payload):
+    """Standard RTCM3 frame for a payload."""
+    head = bytes([PREAMBLE, (len(payload) >> 8) & 0x03, len(payload) & 0xFF])
+    return head + payload + crc24q(head + payload).to_bytes(3, "big")
+
+
+def known_type(payload):
+    """Plausible RTCM3 message type (resync guard)."""
+    if len(payload) < 2:
+        return False
+    msg = get_bits(payload, 0, 12)
+    return 1001 <= msg <= 1230 or 4001 <= msg <= 4095
+
+
+def decode(stream):
+    """Yield payloads from a compact stream (iterator of byte chunks, b"" = quiet gap). Returns on end of stream."""
+    buf = bytearray()
+    synced = True                                   # Start of stream / after a gap is a frame boundary.
+    for chunk in stream:
+        if not chunk:                               # Quiet gap - next byte starts a frame.
+            buf.clear()
+            synced = True
+            continue
+        buf.extend(chunk)
+        while buf:
+            n, head = buf[0], 1
+            if n & 0x80:
+                if len(buf) < 2:
+                    break
+                n, head = (n & 0x7F) | (buf[1] << 7), 2
+                if buf[1] > 7:                      # 10 bit length.
+                    synced = False
+                    del buf[:1]
+                    continue
+            if len(buf) < head + n + 2:
+                break
+            body = bytes(buf[:head + n])
+            ok = crc16(body) == int.from_bytes(buf[head + n:head + n + 2], "big")
+            payload = body[head:]
+            if ok and (synced or known_type(payload)):
+                synced = True
+                del buf[:head + n + 2]
+                yield payload
+            elif synced and crc16(body) ^ 0xFFFF == int.from_bytes(buf[head + n:head + n + 2], "big"):
+                del buf[:head + n + 2]              # Poisoned at the relay (CRC-24Q failed) - skip, still in sync.
+            else:
+                synced = False                      # Hunt byte by byte.
+                del buf[:1]
+
+
+def serial_chunks(path, baud):
+    """Byte chunks from a serial port, b"" on each quiet read timeout (gap)."""
+    import serial                                   # pyserial.
+    with serial.Serial(path, baud, timeout=0.05) as port:
+        while True:
+            yield port.read(256)
+
+
+def report(path):
+    """Compact saving per frame type & per epoch on a capture, plus a round trip check."""
+    per_type = collections.defaultdict(lambda: [0, 0, 0])      # frames, RTCM3 bytes, compact bytes.
+    epochs = []
+    epoch = [0, 0]
+    good = []
+    bad = 0
+    for payload, ok in frames(source(path, 0)):
+        if not ok:
+            bad += 1
+            continue
+        good.append(payload)
+        msg = get_bits(payload, 0, 12)
+        std, hop = len(payload) + 6, len(encode(payload))
+        entry = per_type[msg]
+        entry[0] += 1
+        entry[1] += std
+        entry[2] += hop
+        epoch[0] += std
+        epoch[1] += hop
+        msm = 1071 <= msg <= 1137 and 1 <= msg % 10 <= 7
+        if msm and len(payload) >= 9 and not get_bits(payload, 54, 1):   # Multiple message bit clear - epoch done.
+            epochs.append(epoch)
+            epoch = [0, 0]
+    if not good:
+        sys.exit(f"{path}: no CRC-valid RTCM3 frames")
+
+    print(f"{path}: {len(good)} frames ({bad} CRC errors skipped), {len(epochs)} epochs.")
+    print("  Type  Frames  RTCM3 B  Compact B  Saved")
+    for msg in sorted(per_type):
+        count, std, hop = per_type[msg]
+        print(f"  {msg:4d}  {count:6d}  {std:7d}  {hop:9d}  {100 * (std - hop) / std:4.1f}%")
+    total_std = sum(v[1] for v in per_type.values())
+    total_hop = sum(v[2] for v in per_type.values())
+    print(f"  all   {len(good):6d}  {total_std:7d}  {total_hop:9d}  {100 * (total_std - total_hop) / total_std:4.1f}%")
+    if epochs:
+        saved = sorted(std - hop for std, hop in epochs)
+        print(f"Saved per epoch: mean {sum(saved) / len(saved):.1f} B, min {saved[0]} B, max {saved[-1]} B "
+              f"({1000 * sum(saved) / len(saved) / 960:.0f} ms of 9600 bps air).")
+
+    stream = b"".join(encode(p) for p in good)
+    rebuilt = [rebuild(p) for p in decode(iter([stream[i:i + 61] for i in range(0, len(stream), 61)]))]
+    original = [rebuild(p) for p in good]
+    if rebuilt != original:
+        sys.exit(f"round trip FAILED: {len(rebuilt)} of {len(original)} frames rebuilt, "
+                 f"{sum(a == b for a, b in zip(rebuilt, original))} identical")
+    print(f"Round trip: {len(rebuilt)} frames rebuilt bit-exact.")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1].strip())
+    parser.add_argument("path", help="RTCM3 capture (report) or compact stream / serial port (--decode)")
+    parser.add_argument("--decode", action="store_true", help="rebuild RTCM3 from a compact stream")
+    parser.add_argument("--out", default="-", help="--decode output file (default - = stdout)")
+    parser.add_argument("--baud", type=int, default=9600, help="serial speed (default 9600, HC-12)")
+    args = parser.parse_args()
+
+    if not args.decode:
+        report(args.path)
+        return
+    stream = source(args.path, args.baud) if os.path.isfile(args.path) else serial_chunks(args.path, args.baud)
+    out = sys.stdout.buffer if args.out == "-" else open(args.out, "wb")
+    try:
+        for payload in decode(stream):
+            out.write(rebuild(payload))
+            out.flush()
+    finally:
+        if out is not sys.stdout.buffer:
+            out.close()
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        sys.exit(0)
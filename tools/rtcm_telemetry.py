@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""
+Ghost Rover 3 - RTCM relay telemetry decoder.
+
+Reads an RTCM3 stream (rover side HC-12 serial port, or a capture file), checks every frame's CRC-24Q and prints
+the relay telemetry carried in RTCM 1029 text frames ("GRR1 ..."). Optionally prints a one-line summary of the
+other frames so gaps can be attributed to the base, the relay or the radio.
+
+Usage:
+    rtcm_telemetry.py /dev/ttyUSB0 [--baud 9600] [--all]
+    rtcm_telemetry.py capture.rtcm [--all]
+
+Telemetry fields (see buildTelemetry() in the sketch):
+    n  sequence          u  uptime (s)          fi frames in         fo frames relayed
+    dc CRC errors        dr resyncs             do UART overflows    dd MSM frames decimated
+    q  RX queue high-water (bytes)              a  airtime (%)
+    st stall flags (1 = input stalled now, 2 = stalled during interval)
+
+@since 3.1.0 [2026-10-17-01:30pm] New.
+"""
+
+import argparse
+import os
+import sys
+import time
+
+PREAMBLE = 0xD3
+TELEM_TYPE = 1029
+TELEM_TAG = "GRR1"
+
+
+def crc24q(data):
+    """CRC-24Q over bytes."""
+    crc = 0
+    for b in data:
+        crc ^= b << 16
+        for _ in range(8):
+            crc <<= 1
+            if crc & 0x1000000:
+                crc ^= 0x1864CFB
+    return crc & 0xFFFFFF
+
+
+def get_bits(buf, pos, length):
+    """Unsigned bit field, MSB first."""
+    value = 0
+    for i in range(pos, pos + length):
+        value = (value << 1) | ((buf[i >> 3] >> (7 - (i & 7))) & 1)
+    return value
+
+
+def frames(stream):
+    """Yield (payload, crc_ok) for each RTCM3 frame in a byte iterator. Resyncs on false preambles."""
+    buf = bytearray()
+    for chunk in stream:
+        buf.extend(chunk)
+        while True:
+            start = buf.find(bytes([PREAMBLE]))
+            if start < 0:
+                buf.clear()
+                break
+            del buf[:start]
+            if len(buf) < 3:
+                break
+            if buf[1] & 0xFC:
+                del buf[:1]
+                continue
+            length = ((buf[1] & 0x03) << 8) | buf[2]
+            if len(buf) < length + 6:
+                break
+            frame = bytes(buf[:length + 6])
+            ok = crc24q(frame[:-3]) == int.from_bytes(frame[-3:], "big")
+            if ok:
+                del buf[:length + 6]
+            else:
+                del buf[:1]
+            yield frame[3:-3], ok
+
+
+def decode_telemetry(payload):
+    """Return dict of telemetry fields from an RTCM 1029 payload, or None if it is not relay telemetry."""
+    if len(payload) < 9 or get_bits(payload, 0, 12) != TELEM_TYPE:
+        return None
+    units = get_bits(payload, 64, 8)
+    text = payload[9:9 + units].decode("utf-8", errors="replace")
+    fields = text.split()
+    if not fields or fields[0] != TELEM_TAG:
+        return None
+    result = {"station": get_bits(payload, 12, 12)}
+    for field in fields[1:]:
+        key, _, value = field.partition("=")
+        result[key] = int(value) if value.isdigit() else value
+    return result
+
+
+def source(path, baud):
+    """Byte chunk iterator over a serial port or a file."""
+    if os.path.isfile(path):
+        with open(path, "rb") as f:
+            while True:
+                chunk = f.read(4096)
+                if not chunk:
+                    return
+                yield chunk
+    import serial                       # pyserial.
+    with serial.Serial(path, baud, timeout=0.1) as port:
+        while True:
+            chunk = port.read(256)
+            if chunk:
+                yield chunk
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1].strip())
+    parser.add_argument("path", help="serial port or RTCM3 capture file")
+    parser.add_argument("--baud", type=int, default=9600, help="serial speed (default 9600, HC-12)")
+    parser.add_argument("--all", action="store_true", help="also list non-telemetry frames")
+    args = parser.parse_args()
+
+    last_seq = None
+    for payload, ok in frames(source(args.path, args.baud)):
+        stamp = time.strftime("%H:%M:%S")
+        if not ok:
+            print(f"{stamp} CRC error ({len(payload)} bytes)")
+            continue
+        telemetry = decode_telemetry(payload)
+        if telemetry is None:
+            if args.all:
+                print(f"{stamp} RTCM {get_bits(payload, 0, 12)} ({len(payload)} bytes)")
+            continue
+        seq = telemetry.get("n")
+        lost = "" if last_seq is None or seq == last_seq + 1 else f" [{seq - last_seq - 1} telemetry lost]"
+        last_seq = seq
+        stall = telemetry.get("st", 0)
+        print(f"{stamp} relay n={seq} up={telemetry.get('u')}s in={telemetry.get('fi')} out={telemetry.get('fo')} "
+              f"crc={telemetry.get('dc')} resync={telemetry.get('dr')} ovf={telemetry.get('do')} decim={telemetry.get('dd')} "
+              f"q={telemetry.get('q')}B air={telemetry.get('a')}%"
+              f"{' INPUT STALLED' if stall & 1 else (' input stalled in interval' if stall & 2 else '')}{lost}")
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        sys.exit(0)
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""
+Ghost Rover 3 - RTCM relay firmware update over the USB console.
+
+Streams a new application image (the sketch's .bin, e.g. from arduino-cli compile --export-binaries) into the
+relay's inactive OTA slot while it keeps relaying RTCM. The relay writes one flash sector per inter-epoch gap,
+verifies the image (size, image checks & MD5), then reboots into it in the next gap.
+
+Usage:
+    usb_update.py /dev/ttyACM0 build/DougFoster_Ghost_Rover_EVK_RTCM_relay.ino.bin
+
+Protocol (see startUpdate() in the sketch):
+    -> "update\\n"              <- "UPDATE READY"
+    -> "<size> <md5>\\n"        <- "UPDATE BEGIN <size>" | "UPDATE FAIL <why>"
+    -> image bytes             <- "UPDATE <written>/<size>" ... "UPDATE OK ..." "UPDATE REBOOT" | "UPDATE FAIL <why>"
+
+@since 3.1.0 [2026-10-17-07:00pm] New.
+"""
+
+import argparse
+import hashlib
+import sys
+import time
+
+CHUNK = 4096                        # Host write size (USB flow control paces it to the relay's flash writes).
+
+
+def wait_for(port, prefixes, timeout):
+    """Read console lines until one starts with any of prefixes. Other lines are echoed. Returns the line."""
+    end = time.time() + timeout
+    while time.time() < end:
+        line = port.readline().decode("utf-8", errors="replace").strip()
+        if not line:
+            continue
+        if line.startswith(prefixes):
+            return line
+        print(f"  relay: {line}")
+    raise SystemExit(f"timeout waiting for {' / '.join(prefixes)}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1].strip())
+    parser.add_argument("port", help="relay USB serial port")
+    parser.add_argument("image", help="application .bin")
+    parser.add_argument("--baud", type=int, default=115200, help="console speed (default 115200)")
+    args = parser.parse_args()
+
+    try:
+        import serial
+    except ImportError:
+        sys.exit("pyserial needed: pip install pyserial")
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    md5 = hashlib.md5(image).hexdigest()
+    print(f"{args.image}: {len(image)} bytes, md5 {md5}")
+
+    with serial.Serial(args.port, args.baud, timeout=1, write_timeout=30) as port:
+        port.reset_input_buffer()
+        port.write(b"update\n")
+        wait_for(port, ("UPDATE READY",), 5)
+        port.write(f"{len(image)} {md5}\n".encode())
+        line = wait_for(port, ("UPDATE BEGIN", "UPDATE FAIL"), 10)
+        if line.startswith("UPDATE FAIL"):
+            sys.exit(line)
+
+        start = time.time()
+        for pos in range(0, len(image), CHUNK):
+            port.write(image[pos:pos + CHUNK])
+            done = min(pos + CHUNK, len(image))
+            rate = done / max(time.time() - start, 0.001) / 1024
+            print(f"\r  sent {done}/{len(image)} ({100 * done // len(image)}%, {rate:.1f} KiB/s)", end="", flush=True)
+            while port.in_waiting:
+                line = port.readline().decode("utf-8", errors="replace").strip()
+                if line.startswith("UPDATE FAIL"):
+                    sys.exit(f"\n{line}")
+        print()
+
+        line = wait_for(port, ("UPDATE OK", "UPDATE FAIL"), 120)
+        print(line)
+        if line.startswith("UPDATE FAIL"):
+            sys.exit(1)
+        wait_for(port, ("UPDATE REBOOT",), 30)
+        print(f"Rebooting into the new image ({time.time() - start:.0f} s).")
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        sys.exit(130)
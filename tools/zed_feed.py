@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+"""
+Ghost Rover 3 - RTCM relay ZED stream generator & speed detection check.
+
+Stands in for the EVK's ZED-F9P UART2: 1 Hz epochs of RTCM3 (a capture, or synthetic MSM7 epochs) at chosen
+speeds, to check the relay's ZED speed detection (see checkBaud() in the sketch).
+
+  Default: no hardware. For each ZED speed, the stream is sampled by a model UART (8N1, start bit
+      edge, mid-bit samples) at each candidate speed the relay tries, in the relay's order, with the sketch's
+      window & lock rules. Reports the speed locked, the time to lock & the valid frames per candidate.
+  --port: writes the stream to a USB-UART adapter wired to the relay's RTCM_IN (ZED TX2 unplugged), switching
+      speed every --seconds; "baud" on the relay console (or --relay PORT) shows what it locked to.
+
+Usage:
+    zed_feed.py [--rates 57600,115200,230400,460800,921600] [--start 57600] [capture.rtcm]
+    zed_feed.py --port /dev/ttyUSB0 --rates 57600,115200 --seconds 20 [--relay /dev/ttyACM0]
+
+@since 3.1.1 [2026-10-18-04:30am] New.
+"""
+
+import argparse
+import time
+
+from epoch_forecast import synthetic
+from rtcm_hop import rebuild
+from rtcm_telemetry import crc24q, frames, get_bits, source
+
+BAUD_RATES = [57600, 115200, 230400, 460800, 921600, 38400, 19200, 9600]
+BAUD_WINDOW_MS = 1500
+BAUD_MIN_BYTES = 64
+BAUD_MIN_FRAMES = 2
+PERIOD_MS = 1000
+
+
+def epoch_bursts(path, count):
+    """RTCM3 bytes per epoch (list of bytes), from a capture or synthetic."""
+    if path:
+        payloads = (p for p, ok in frames(source(path, 0)) if ok)
+    else:
+        payloads = synthetic(count, 1)
+    bursts, burst = [], bytearray()
+    for payload in payloads:
+        burst += rebuild(payload)
+        msg = get_bits(payload, 0, 12)
+        if 1071 <= msg <= 1137 and 1 <= msg % 10 <= 7 and not get_bits(payload, 54, 1):
+            bursts.append(bytes(burst))
+            burst = bytearray()
+    return bursts
+
+
+class Line:
+    """ZED TX line level over time: one burst per epoch at tx bps, idle (1) between."""
+
+    def __init__(self, bursts, tx):
+        self.bursts = bursts
+        self.bit_ms = 1000.0 / tx
+
+    def level(self, t):
+        n, offset = divmod(t, PERIOD_MS)
+        burst = self.bursts[int(n) % len(self.bursts)]
+        bit = int(offset / self.bit_ms)
+        if bit >= 10 * len(burst):
+            return 1
+        pos = bit % 10
+        return 0 if pos == 0 else 1 if pos == 9 else (burst[bit // 10] >> (pos - 1)) & 1
+
+    def next_level(self, t, want):
+        """Earliest time >= t with the line at want."""
+        while True:
+            n, offset = divmod(t, PERIOD_MS)
+            bit = int(offset / self.bit_ms)
+            if bit >= 10 * len(self.bursts[int(n) % len(self.bursts)]):
+                if want == 1:
+                    return t
+                t = (n + 1) * PERIOD_MS                         # Idle to the next burst.
+                continue
+            if self.level(t) == want:
+                return t
+            t = n * PERIOD_MS + (bit + 1) * self.bit_ms + 1e-9   # Next TX bit.
+
+
+def receive(line, rx, start, end):
+    """(time ms, byte) the relay's UART reads at rx bps between start & end (8N1, samples mid-bit)."""
+    bit_ms = 1000.0 / rx
+    out = []
+    t = line.next_level(start, 1)
+    while True:
+        t = line.next_level(t, 0)                               # Start bit edge.
+        if t >= end:
+            return out
+        if line.level(t + bit_ms / 2) != 0:                     # Glitch, not a start bit.
+            t = line.next_level(t, 1)
+            continue
+        value = 0
+        for k in range(8):
+            value |= line.level(t + (1.5 + k) * bit_ms) << k
+        out.append((t + 9.5 * bit_ms, value))                   # Framing errors are still delivered.
+        t = line.next_level(t + 9.5 * bit_ms, 1)
+
+
+def parse(received):
+    """(time ms, crc ok) per frame, like rtcmParse()."""
+    events = []
+    buf = bytearray()
+    for t, b in received:
+        if not buf and b != 0xD3:
+            continue
+        buf.append(b)
+        if len(buf) == 2 and buf[1] & 0xFC:                        # Reserved bits - false preamble.
+            buf.clear()
+            continue
+        if len(buf) >= 3 and len(buf) == (((buf[1] & 0x03) << 8) | buf[2]) + 6:
+            events.append((t, crc24q(buf[:-3]) == int.from_bytes(buf[-3:], "big")))
+            buf.clear()
+    return events
+
+
+def candidates(start):
+    return [start] + [r for r in BAUD_RATES if r != start]
+
+
+def simulate(bursts, zed, start, t0):
+    """Run the relay's scan (checkBaud()) against a ZED at zed bps. Returns (locked bps, lock ms, scores)."""
+    line = Line(bursts, zed)
+    rates = candidates(start)
+    scores = [0] * len(rates)
+    t = t0
+    for idx, rx in enumerate(rates):
+        got = receive(line, rx, t, t + 20 * PERIOD_MS)
+        if len(got) < BAUD_MIN_BYTES:
+            return None, None, scores
+        window_end = got[BAUD_MIN_BYTES - 1][0] + BAUD_WINDOW_MS
+        ok = bad = 0
+        need = 1 if idx == 0 else BAUD_MIN_FRAMES
+        for when, crc_ok in parse(g for g in got if g[0] < window_end):
+            ok, bad = ok + crc_ok, bad + (not crc_ok)
+            if ok >= need and ok > bad:
+                scores[idx] = ok
+                return rx, when - t0, scores
+        scores[idx] = ok
+        t = window_end
+    best = max(range(len(rates)), key=lambda i: scores[i])
+    return (rates[best] if scores[best] else None), t - t0, scores
+
+
+def feed(args, bursts):
+    """Write epochs to a serial port at each rate for --seconds."""
+    import serial                                               # pyserial.
+    relay = None
+    if args.relay:
+        from relay_client import Relay
+        relay = Relay(args.relay)
+    with serial.Serial(args.port, args.rates[0]) as port:
+        for rate in args.rates:
+            port.baudrate = rate
+            print(f"Feeding {rate} bps for {args.seconds} s.")
+            end = time.time() + args.seconds
+            n = 0
+            while time.time() < end:
+                port.write(bursts[n % len(bursts)])
+                n += 1
+                time.sleep(max(0.0, PERIOD_MS / 1000 - (time.time() % (PERIOD_MS / 1000))))
+            if relay:
+                relay.command("baud")
+                stop = time.time() + 1.0
+                while time.time() < stop:
+                    relay._pump()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1].strip())
+    parser.add_argument("capture", nargs="?", help="RTCM3 capture (default synthetic MSM7 epochs)")
+    parser.add_argument("--rates", default="57600,115200,230400,460800,921600", help="ZED speeds (bps)")
+    parser.add_argument("--start", type=int, default=57600, help="relay's cfg serial0 (first tried, default 57600)")
+    parser.add_argument("--port", help="USB-UART adapter to the relay's RTCM_IN (feed instead of simulate)")
+    parser.add_argument("--seconds", type=float, default=20.0, help="--port: time per rate (s)")
+    parser.add_argument("--relay", help="--port: relay USB console, \"baud\" after each rate")
+    args = parser.parse_args()
+    args.rates = [int(r) for r in args.rates.split(",")]
+
+    bursts = epoch_bursts(args.capture, 60)
+    if not bursts:
+        raise SystemExit("no MSM epochs")
+    if args.port:
+        feed(args, bursts)
+        return
+    print(f"{len(bursts)} epochs, {sum(map(len, bursts)) // len(bursts)} bytes/epoch; "
+          f"relay starts at {args.start} bps.")
+    failed = 0
+    for zed in args.rates:
+        for t0 in (137.0, 611.0):                                   # Relay boots mid-gap & mid-burst.
+            locked, ms, scores = simulate(bursts, zed, args.start, t0)
+            tried = " ".join(f"{r}={s}" for r, s in zip(candidates(args.start), scores) if s or r == locked)
+            status = "ok" if locked == zed else "FAIL"
+            failed += locked != zed
+            print(f"  ZED {zed:6d}  boot +{t0:5.0f} ms: locked {locked}  in {ms:6.0f} ms  [{tried}]  {status}")
+    raise SystemExit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        raise SystemExit(130)